@@ -0,0 +1,79 @@
+/*  Heap traffic of a dynamic_poly expression chain, with the standard
+ *  allocator and with a poly_arena.  Build with optimization, e.g.
+ *     g++ -std=c++14 -O2 -I.. arena.cpp -o arena
+ *  The chain is the cyclotomic division of example.cpp,
+ *  (x^15 - 1) / phi5 / phi3 / phi1, at run time.  For each allocator it
+ *  prints the time per evaluation of the chain and the heap allocations
+ *  (operator new calls) per evaluation, in the first run and after it.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include "../poly_arena.hpp"
+
+// std::allocator, counting its allocations
+static std::size_t heap_allocations = 0;
+
+template <class T>
+struct counting_allocator : std::allocator<T> {
+   template <class U>
+   struct rebind {
+      typedef counting_allocator<U> other;
+   };
+
+   counting_allocator() = default;
+
+   template <class U>
+   counting_allocator(const counting_allocator<U>&) {}
+
+   T* allocate(std::size_t n) {
+      ++heap_allocations;
+      return std::allocator<T>::allocate(n);
+   }
+};
+
+template <class T, class U>
+bool operator == (const counting_allocator<T>&, const counting_allocator<U>&) {
+   return true;
+}
+
+// the cyclotomic polynomial 15, with polynomials on alloc
+template <class Poly>
+Poly phi15(const typename Poly::allocator_type& alloc) {
+   const Poly x({0, 1}, alloc);
+   const Poly phi1({-1, 1}, alloc), phi3({1, 1, 1}, alloc), phi5({1, 1, 1, 1, 1}, alloc);
+   return (power(x, 15) - 1) / phi5 / phi3 / phi1;
+}
+
+template <class Poly, class Count>
+void run(const char* name, const typename Poly::allocator_type& alloc, Count heap) {
+   typedef std::chrono::steady_clock clock;
+   const std::size_t before = heap();
+   volatile int sink = phi15<Poly>(alloc).degree();
+   const std::size_t first = heap() - before;
+   const int reps = 200000;
+   const clock::time_point start = clock::now();
+   for (int r = 0; r < reps; ++r)
+      sink = phi15<Poly>(alloc).degree();
+   const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / reps;
+   const double later = double(heap() - before - first) / reps;
+   std::printf("%-16s %10.1f ns %14zu %16.2f\n", name, ns, first, later);
+   if (sink != 8)
+      std::abort();
+}
+
+int main() {
+   std::printf("%-16s %13s %14s %16s\n", "allocator", "time", "first run", "later runs");
+   run<dynamic_poly<int, counting_allocator<int> > >("std::allocator", counting_allocator<int>(),
+                                                     [] { return heap_allocations; });
+   poly_arena arena;
+   run<arena_poly<int> >("poly_arena", arena_allocator<int>(arena),
+                         [&] { return arena.stats().blocks; });
+   const poly_arena_stats& s = arena.stats();
+   std::printf("arena: %zu blocks, %zu bytes, %zu allocations served, peak %zu bytes in use\n",
+               s.blocks, s.block_bytes, s.allocations, s.peak_bytes_in_use);
+}
@@ -0,0 +1,93 @@
+/*  Compensated Horner against Horner's rule in double and in long double.
+ *  Build with optimization, e.g.
+ *     g++ -std=c++14 -O2 -I.. compensated.cpp -o compensated
+ *  and again with -march=native (or -mfma) to see the fma path.  For 8 to 64
+ *  terms it evaluates (x - 2)^(N-1), multiplied out, at points near 2 and
+ *  prints for each method the nanoseconds per evaluation when each waits on
+ *  the one before (latency) and when they're independent (throughput), and
+ *  the largest error, in units of the condition Σ|a_i||x|^i: about the unit
+ *  roundoff for Horner's rule, its square for the compensated rule.  The
+ *  errors are measured against the compensated rule in long double.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "../compensated.hpp"
+
+const int points = 1024;
+
+template <int N>
+static_poly<double, N> shifted_power() {
+   static_poly<double, N> p;
+   p[0] = 1;
+   for (int k = 0; k + 1 < N; ++k) {
+      for (int i = k + 1; i > 0; --i)
+         p[i] = p[i - 1] - 2 * p[i];
+      p[0] *= -2;
+   }
+   return p;
+}
+
+enum method { horner, horner_long, compensated, compensated_bound };
+
+template <int N>
+double evaluate(const static_poly<double, N>& p, const static_poly<long double, N>& pl, double x, method m) {
+   switch (m) {
+   case horner: return p.template evaluate<horner_scheme<1> >(x);
+   case horner_long: return double(pl.template evaluate<horner_scheme<1> >(x));
+   case compensated: return evaluate_compensated(p, x);
+   default: return evaluate_compensated_bound(p, x).m_value;
+   }
+}
+
+template <int N>
+void run() {
+   typedef std::chrono::steady_clock clock;
+   const static_poly<double, N> p = shifted_power<N>();
+   static_poly<long double, N> pl;
+   for (int i = 0; i < N; ++i)
+      pl[i] = p[i];
+   double xs[points];
+   for (int i = 0; i < points; ++i)
+      xs[i] = 1.95 + 0.1 * i / points;
+   std::printf("%4d", N);
+   for (int m = horner; m <= compensated_bound; ++m) {
+      double worst = 0, sink = 0;
+      for (int i = 0; i < points; ++i) {
+         const bounded_value<long double> exact = evaluate_compensated_bound(pl, (long double)xs[i]);
+         long double condition = 0;
+         for (int j = N - 1; j >= 0; --j)
+            condition = condition * std::fabs(xs[i]) + std::fabs(pl[j]);
+         const double e = double(std::fabs(evaluate(p, pl, xs[i], method(m)) - exact.m_value) / condition);
+         worst = e > worst ? e : worst;
+      }
+      double ns[2];
+      for (int dependent = 1; dependent >= 0; --dependent) {
+         int reps = 0;
+         const clock::time_point start = clock::now();
+         do {
+            for (int i = 0; i < points; ++i) // 0 * sink, as it may be NaN, doesn't fold away
+               sink += evaluate(p, pl, dependent ? xs[i] + 0 * sink : xs[i], method(m));
+            ++reps;
+         } while (clock::now() - start < std::chrono::milliseconds(100));
+         ns[dependent] = std::chrono::duration<double, std::nano>(clock::now() - start).count() / reps / points;
+      }
+      std::printf(" %6.1f %6.1f %7.0e", ns[1], ns[0] + 0 * sink, worst);
+   }
+   std::printf("\n");
+}
+
+int main() {
+   std::printf("%4s %21s %21s %21s %21s\n", "N", "Horner", "long double", "compensated", "with bound");
+   std::printf("%4s", "");
+   for (int m = 0; m < 4; ++m)
+      std::printf(" %6s %6s %7s", "lat", "thru", "error");
+   std::printf("\n");
+   run<8>();
+   run<16>();
+   run<32>();
+   run<64>();
+}
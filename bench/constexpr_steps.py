@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+#  Smallest constexpr evaluation budget a source file compiles with.
+#  Use, modification and distribution are subject to the
+#  Boost Software License, Version 1.0. (See accompanying file
+#  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+"""Find the smallest constexpr step limit that SOURCE compiles with.
+
+    constexpr_steps.py [--cxx COMPILER] SOURCE [COMPILER FLAGS...]
+
+The limit is -fconstexpr-steps for clang and -fconstexpr-ops-limit for GCC
+(GCC 9 and later); the two count differently, so only compare numbers from the
+same compiler.  For example, to see what exact division by monic divisors
+saves:
+
+    bench/constexpr_steps.py bench/monic_division.cpp -DNAM_STATIC_POLY_MONIC_DIVISION=0
+    bench/constexpr_steps.py bench/monic_division.cpp
+"""
+
+import os
+import subprocess
+import sys
+
+
+def limit_flag(cxx):
+    version = subprocess.run([cxx, '--version'], capture_output=True, text=True).stdout
+    return '-fconstexpr-steps=' if 'clang' in version else '-fconstexpr-ops-limit='
+
+
+def compiles(cxx, source, flags, limit):
+    cmd = [cxx, '-std=c++14', '-fsyntax-only', limit, source] + flags
+    return subprocess.run(cmd, capture_output=True).returncode == 0
+
+
+def min_steps(cxx, source, flags, precision=0.01):
+    """Bisect for the limit, to within the given relative precision."""
+    flag = limit_flag(cxx)
+    compiles_with = lambda limit: compiles(cxx, source, flags, flag + str(limit))
+    lo, hi = 1, 1 << 10
+    while not compiles_with(hi):
+        lo, hi = hi + 1, hi * 2
+        if hi > 1 << 40:
+            raise RuntimeError('%s does not compile with any step limit' % source)
+    while hi - lo > hi * precision:
+        mid = (lo + hi) // 2
+        if compiles_with(mid):
+            hi = mid
+        else:
+            lo = mid + 1
+    return hi
+
+
+def main(argv):
+    cxx = os.environ.get('CXX', 'g++')
+    if argv[:1] == ['--cxx']:
+        cxx, argv = argv[1], argv[2:]
+    if not argv:
+        sys.exit(__doc__)
+    print(min_steps(cxx, argv[0], argv[1:]))
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
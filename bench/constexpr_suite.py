@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+#  Compile-time cost of a matrix of constexpr polynomial workloads.
+#  Use, modification and distribution are subject to the
+#  Boost Software License, Version 1.0. (See accompanying file
+#  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+"""Measure the compile-time cost of constexpr polynomial workloads.
+
+    constexpr_suite.py [--cxx COMPILER] [--repeat N] [--only NAME] [--output FILE]
+                       [--compare BASELINE] [COMPILER FLAGS...]
+
+Each workload (constexpr_workloads.cpp at several sizes, monic_division.cpp
+and example.cpp) is measured for
+  steps     the smallest constexpr step limit it compiles with
+            (constexpr_steps.py; GCC and clang count differently),
+  seconds   the best wall-clock time of --repeat compilations (-fsyntax-only,
+            so this is the front end, where constant evaluation happens),
+  peak_kib  the peak resident memory of the compiler in those compilations.
+The report is JSON, one workload per line, so reports from two versions can
+be compared with diff, or with --compare, which prints the ratios against an
+earlier report.  Extra arguments go to the compiler, e.g.
+-DNAM_STATIC_POLY_KARATSUBA_THRESHOLD=32.
+"""
+
+import json
+import os
+import subprocess
+import sys
+import time
+
+from constexpr_steps import limit_flag, min_steps
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+WORKLOADS_CPP = os.path.join(HERE, 'constexpr_workloads.cpp')
+
+# (name, source, flags)
+WORKLOADS = (
+    [('product/%d' % n, WORKLOADS_CPP, ['-DBENCH_PRODUCT', '-DBENCH_SIZE=%d' % n])
+     for n in (16, 64, 256)]
+    + [('power/%d' % n, WORKLOADS_CPP, ['-DBENCH_POWER', '-DBENCH_SIZE=%d' % n])
+       for n in (8, 32, 128)]
+    + [('division/%d' % n, WORKLOADS_CPP, ['-DBENCH_DIVISION', '-DBENCH_SIZE=%d' % n])
+       for n in (16, 64, 256)]
+    + [('cyclotomic/%d' % n, WORKLOADS_CPP, ['-DBENCH_CYCLOTOMIC', '-DBENCH_SIZE=%d' % n])
+       for n in (15, 105, 1155)]
+    + [('gcd/%d' % n, WORKLOADS_CPP, ['-DBENCH_GCD', '-DBENCH_SIZE=%d' % n])
+       for n in (8, 16, 32)]
+    + [('squarefree/%d' % n, WORKLOADS_CPP, ['-DBENCH_SQUAREFREE', '-DBENCH_SIZE=%d' % n])
+       for n in (4, 8, 16)]
+    + [('resultant/%d' % n, WORKLOADS_CPP, ['-DBENCH_RESULTANT', '-DBENCH_SIZE=%d' % n])
+       for n in (4, 8, 16)]
+    + [('monic_division', os.path.join(HERE, 'monic_division.cpp'), []),
+       ('example', os.path.join(HERE, '..', 'example.cpp'), [])])
+
+
+def compile_cost(cxx, source, flags, limit):
+    """Wall-clock seconds and peak memory (KiB) of one compilation."""
+    cmd = [cxx, '-std=c++14', '-fsyntax-only', limit, source] + flags
+    start = time.perf_counter()
+    proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    # the usage of the driver includes the compiler proper it waited for
+    _, status, usage = os.wait4(proc.pid, 0)
+    seconds = time.perf_counter() - start
+    if status:
+        raise RuntimeError('failed: ' + ' '.join(cmd))
+    return seconds, usage.ru_maxrss  # KiB on Linux
+
+
+def measure(cxx, source, flags, repeat):
+    steps = min_steps(cxx, source, flags)
+    limit = limit_flag(cxx) + str(2 * steps)
+    costs = [compile_cost(cxx, source, flags, limit) for _ in range(repeat)]
+    return {'steps': steps,
+            'seconds': round(min(c[0] for c in costs), 3),
+            'peak_kib': max(c[1] for c in costs)}
+
+
+def write_report(report, out):
+    # one workload per line, for diffs
+    out.write('{\n "compiler": %s,\n "flags": %s,\n "results": [\n'
+              % (json.dumps(report['compiler']), json.dumps(report['flags'])))
+    out.write(',\n'.join('  ' + json.dumps(r, sort_keys=True) for r in report['results']))
+    out.write('\n ]\n}\n')
+
+
+def compare(report, baseline):
+    old = {r['workload']: r for r in baseline['results']}
+    print('%-16s %10s %10s %10s' % ('workload', 'steps', 'seconds', 'peak'), file=sys.stderr)
+    for r in report['results']:
+        b = old.get(r['workload'])
+        if b:
+            print('%-16s %10.2f %10.2f %10.2f' % (r['workload'], r['steps'] / b['steps'],
+                  r['seconds'] / max(b['seconds'], 1e-3), r['peak_kib'] / b['peak_kib']),
+                  file=sys.stderr)
+
+
+def main(argv):
+    cxx, repeat, only, output, baseline = os.environ.get('CXX', 'g++'), 3, None, None, None
+    while argv and argv[0] in ('--cxx', '--repeat', '--only', '--output', '--compare'):
+        opt, value, argv = argv[0], argv[1], argv[2:]
+        if opt == '--cxx':
+            cxx = value
+        elif opt == '--repeat':
+            repeat = int(value)
+        elif opt == '--only':
+            only = value
+        elif opt == '--output':
+            output = value
+        else:
+            with open(value) as f:
+                baseline = json.load(f)
+    version = subprocess.run([cxx, '--version'], capture_output=True, text=True).stdout
+    report = {'compiler': version.splitlines()[0], 'flags': argv, 'results': []}
+    for name, source, flags in WORKLOADS:
+        if only and not name.startswith(only):
+            continue
+        result = {'workload': name}
+        result.update(measure(cxx, source, flags + argv, repeat))
+        print(json.dumps(result, sort_keys=True), file=sys.stderr)
+        report['results'].append(result)
+    if output:
+        with open(output, 'w') as f:
+            write_report(report, f)
+    else:
+        write_report(report, sys.stdout)
+    if baseline:
+        compare(report, baseline)
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
@@ -0,0 +1,142 @@
+/*  Constexpr workloads for bench/constexpr_suite.py: one per compilation,
+ *  chosen with -DBENCH_<WORKLOAD> and sized with -DBENCH_SIZE=n.
+ *    BENCH_PRODUCT     n terms times n terms, long long
+ *    BENCH_POWER       (1 + x + x^2)^n, unsigned long long (wrapping is fine)
+ *    BENCH_DIVISION    a product of three factors of n terms, double,
+ *                      divided by two of them in turn
+ *    BENCH_CYCLOTOMIC  the cyclotomic polynomial of n = 15, 105 or 1155
+ *    BENCH_GCD         the gcd of f g and f h, for f, g and h of n terms,
+ *                      long long
+ *    BENCH_SQUAREFREE  the squarefree part of f^2 g, for f and g of n terms,
+ *                      long long
+ *    BENCH_RESULTANT   the resultant of two polynomials of n terms, modulo
+ *                      a prime
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#include "../static_poly.hpp"
+#include "../gcd.hpp"
+
+#ifndef BENCH_SIZE
+#  define BENCH_SIZE 64
+#endif
+
+// n made up coefficients in [-6, 6], with a nonzero leading one
+template <class T, int n>
+constexpr static_poly<T, n> sample(int seed) {
+   static_poly<T, n> p;
+   for (int i = 0; i < n; ++i)
+      p[i] = T((i * 7 + seed * 5) % 13 - 6);
+   if (p[n - 1] == T(0))
+      p[n - 1] = T(1);
+   return p;
+}
+
+// f(x^p)
+template <int p, class T, int N>
+constexpr static_poly<T, (N - 1) * p + 1> of_power(const static_poly<T, N>& f) {
+   static_poly<T, (N - 1) * p + 1> g;
+   for (int i = 0; i < N; ++i)
+      g[i * p] = f[i];
+   return g;
+}
+
+// the cyclotomic polynomial of p, prime: 1 + x + ... + x^(p-1)
+template <int p>
+constexpr static_poly<int, p> cyclotomic() {
+   static_poly<int, p> phi;
+   for (int i = 0; i < p; ++i)
+      phi[i] = 1;
+   return phi;
+}
+
+// of the product of distinct primes p, q, ...: phi_np(x) = phi_n(x^p) / phi_n(x)
+template <int p, int q, int... rest>
+constexpr auto cyclotomic() {
+   const auto phi = cyclotomic<q, rest...>();
+   return of_power<p>(phi) / phi;
+}
+
+#if defined(BENCH_PRODUCT)
+constexpr auto result = sample<long long, BENCH_SIZE>(1) * sample<long long, BENCH_SIZE>(2);
+static_assert(result.degree() == 2 * BENCH_SIZE - 2, "product");
+
+#elif defined(BENCH_POWER)
+constexpr auto result = power<BENCH_SIZE>(static_poly<unsigned long long, 3>{1, 1, 1});
+static_assert(result[2 * BENCH_SIZE] == 1, "power");
+
+#elif defined(BENCH_DIVISION)
+constexpr auto f = sample<double, BENCH_SIZE>(1), g = sample<double, BENCH_SIZE>(2),
+               h = sample<double, BENCH_SIZE>(3);
+constexpr auto result = f * g * h / h / g;
+static_assert(result.degree() == BENCH_SIZE - 1, "division");
+
+#elif defined(BENCH_CYCLOTOMIC)
+#  if BENCH_SIZE == 15
+constexpr auto result = cyclotomic<5, 3>();
+static_assert(result.degree() == 8, "phi15");
+#  elif BENCH_SIZE == 105
+constexpr auto result = cyclotomic<7, 5, 3>();
+static_assert(result.degree() == 48 && result[7] == -2, "phi105");
+#  elif BENCH_SIZE == 1155
+constexpr auto result = cyclotomic<11, 7, 5, 3>();
+static_assert(result.degree() == 480, "phi1155");
+#  else
+#    error "BENCH_CYCLOTOMIC takes BENCH_SIZE 15, 105 or 1155"
+#  endif
+
+#elif defined(BENCH_GCD)
+constexpr auto f = sample<long long, BENCH_SIZE>(1), g = sample<long long, BENCH_SIZE>(2),
+               h = sample<long long, BENCH_SIZE>(3);
+constexpr auto result = gcd(f * g, f * h);
+static_assert(result.degree() == BENCH_SIZE - 1, "gcd");
+
+#elif defined(BENCH_SQUAREFREE)
+constexpr auto f = sample<long long, BENCH_SIZE>(1), g = sample<long long, BENCH_SIZE>(2);
+constexpr auto result = squarefree_part(f * f * g);
+static_assert(result.degree() == 2 * BENCH_SIZE - 2, "squarefree");
+
+#elif defined(BENCH_RESULTANT)
+// the integers modulo the prime 2^31 - 1: resultants need exact coefficients,
+// and over long long these overflow from 8 terms
+struct mod_prime {
+   static constexpr long long p = 2147483647;
+   long long m_value;
+
+   constexpr mod_prime(long long v = 0) : m_value((v % p + p) % p) {}
+
+   constexpr mod_prime operator- () const { return mod_prime(-m_value); }
+   constexpr mod_prime& operator+= (mod_prime b) { return *this = mod_prime(m_value + b.m_value); }
+   constexpr mod_prime& operator-= (mod_prime b) { return *this = mod_prime(m_value - b.m_value); }
+   constexpr mod_prime& operator*= (mod_prime b) { return *this = mod_prime(m_value * b.m_value); }
+   constexpr mod_prime& operator/= (mod_prime b) { // times b^(p-2), b's inverse
+      mod_prime r = 1;
+      for (long long e = p - 2; e; e >>= 1, b *= b)
+         if (e & 1)
+            r *= b;
+      return *this *= r;
+   }
+   friend constexpr mod_prime operator+ (mod_prime a, mod_prime b) { return a += b; }
+   friend constexpr mod_prime operator- (mod_prime a, mod_prime b) { return a -= b; }
+   friend constexpr mod_prime operator* (mod_prime a, mod_prime b) { return a *= b; }
+   friend constexpr mod_prime operator/ (mod_prime a, mod_prime b) { return a /= b; }
+   friend constexpr bool operator== (mod_prime a, mod_prime b) { return a.m_value == b.m_value; }
+   friend constexpr bool operator!= (mod_prime a, mod_prime b) { return a.m_value != b.m_value; }
+};
+
+namespace std {
+   template <>
+   struct numeric_limits<mod_prime> {
+      static constexpr bool is_specialized = true, is_exact = true;
+   };
+}
+
+constexpr mod_prime result = resultant(sample<mod_prime, BENCH_SIZE>(1), sample<mod_prime, BENCH_SIZE>(2));
+static_assert(result != 0, "resultant");
+
+#else
+#  error "define one of BENCH_PRODUCT, BENCH_POWER, BENCH_DIVISION, BENCH_CYCLOTOMIC, BENCH_GCD, BENCH_SQUAREFREE, BENCH_RESULTANT"
+#endif
+
+int main() {}
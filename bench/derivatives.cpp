@@ -0,0 +1,72 @@
+/*  evaluate_with_derivatives against evaluating p and its derivative apart.
+ *  Build with optimization, e.g.
+ *     g++ -std=c++14 -O2 -march=native -I.. derivatives.cpp -o derivatives
+ *  For 8 to 32 terms it prints the nanoseconds per point for p(x) and p'(x)
+ *  when each point waits on the one before (latency): with derivative(p)
+ *  built for every point, as when p changes between calls; with it built
+ *  once, beforehand; and fused.  Then the same for independent points
+ *  (throughput), fused one point at a time and by
+ *  evaluate_with_derivatives_many.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#include <chrono>
+#include <cstdio>
+#include "../derivatives.hpp"
+
+const int points = 1024;
+
+enum method { built, prebuilt, fused, many };
+
+template <int N>
+void run() {
+   typedef std::chrono::steady_clock clock;
+   static_poly<double, N> p;
+   for (int i = 0; i < N; ++i)
+      p[i] = 1.0 / (i + 1);
+   const static_poly<double, N - 1> dp = derivative(p);
+   double xs[points];
+   for (int i = 0; i < points; ++i)
+      xs[i] = -1 + 2.0 * i / points;
+   derivative_values<double, 1> out[points];
+   std::printf("%4d", N);
+   for (int m = built; m <= many; ++m) {
+      for (int dependent = 1; dependent >= 0; --dependent) {
+         if (dependent ? m == many : m != fused && m != many)
+            continue;
+         double sink = 0;
+         int reps = 0;
+         const clock::time_point start = clock::now();
+         do {
+            if (m == many) {
+               evaluate_with_derivatives_many<1>(p, xs, out, points);
+               sink += out[reps % points][1];
+            }
+            for (int i = 0; i < points && m != many; ++i) {
+               const double x = dependent ? xs[i] + 0 * sink : xs[i];
+               if (m == built) {
+                  p[N - 1] += 0 * sink; // so that derivative(p) can't be hoisted
+                  sink += p(x) + derivative(p)(x);
+               } else if (m == prebuilt)
+                  sink += p(x) + dp(x);
+               else {
+                  const derivative_values<double, 1> d = evaluate_with_derivatives<1>(p, x);
+                  sink += d[0] + d[1];
+               }
+            }
+            ++reps;
+         } while (clock::now() - start < std::chrono::milliseconds(100));
+         std::printf(" %6.1f", std::chrono::duration<double, std::nano>(clock::now() - start).count() / reps / points + 0 * sink);
+      }
+   }
+   std::printf("\n");
+}
+
+int main() {
+   std::printf("            latency        throughput\n");
+   std::printf("   N  built prebuilt fused  fused   many\n");
+   run<8>();
+   run<16>();
+   run<32>();
+}
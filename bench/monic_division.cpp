@@ -0,0 +1,39 @@
+/*  Constexpr workload for integral long division by divisors with leading
+ *  coefficient ±1: cyclotomic polynomials, as in example.cpp, built by
+ *  dividing x^n - 1 by the cyclotomic polynomials of the divisors of n.
+ *  Compile with -DNAM_STATIC_POLY_MONIC_DIVISION=0 for pseudo-division.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#include "../static_poly.hpp"
+
+// x^n - 1
+template <int n>
+constexpr static_poly<int, n + 1> xn_minus_1() {
+   static_poly<int, n + 1> p;
+   p[0] = -1;
+   p[n] = 1;
+   return p;
+}
+
+constexpr static_poly<int, 2> phi1{-1, 1};
+constexpr auto phi3 = xn_minus_1<3>() / phi1;
+constexpr auto phi5 = xn_minus_1<5>() / phi1;
+constexpr auto phi7 = xn_minus_1<7>() / phi1;
+constexpr auto phi15 = xn_minus_1<15>() / phi5 / phi3 / phi1;
+constexpr auto phi21 = xn_minus_1<21>() / phi7 / phi3 / phi1;
+constexpr auto phi35 = xn_minus_1<35>() / phi7 / phi5 / phi1;
+constexpr auto phi105 = xn_minus_1<105>() / phi35 / phi21 / phi15 / phi7 / phi5 / phi3 / phi1;
+// -(x^n - 1) / -phi_1 exercises a leading coefficient of -1
+constexpr auto phi105_neg = -xn_minus_1<105>() / -phi1 / phi35 / phi21 / phi15 / phi7 / phi5 / phi3;
+
+static_assert(phi105.degree() == 48 && phi105[7] == -2 && phi105[41] == -2, "phi105");
+#if NAM_STATIC_POLY_MONIC_DIVISION
+static_assert(phi105_neg == phi105, "phi105, dividing by -1");
+#else
+// pseudo-division by -1 gives the quotient times (-1)^(m-n+1)
+static_assert(phi105_neg == -phi105, "phi105, pseudo-dividing by -1");
+#endif
+
+int main() {}
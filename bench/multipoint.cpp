@@ -0,0 +1,48 @@
+/*  Multipoint evaluation by subproduct tree against Horner's rule at every
+ *  point.  Build with optimization, e.g.
+ *     g++ -std=c++14 -O2 -I.. multipoint.cpp -o multipoint
+ *  For n from 256 to 8192 it evaluates a polynomial of n terms at n points
+ *  both ways, for unsigned long long (exact, wrapping) and double, and prints
+ *  the microseconds per evaluation of all the points.  double stays on
+ *  Horner's rule unless built with the field threshold lowered, e.g.
+ *  -DNAM_STATIC_POLY_MULTIPOINT_FIELD_THRESHOLD=1024 (fast, but see
+ *  multipoint.hpp on accuracy); lower both thresholds to see where the tree
+ *  starts to pay.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../multipoint.hpp"
+
+template <class T>
+double run(int n, bool tree) {
+   typedef std::chrono::steady_clock clock;
+   dynamic_poly<T> p;
+   for (int i = 0; i < n; ++i)
+      p.set(i, T(i % 5 + 1));
+   std::vector<T> xs(n), out(n);
+   for (int i = 0; i < n; ++i)
+      xs[i] = T(i * 7 + 3);
+   int reps = 0;
+   const clock::time_point start = clock::now();
+   do {
+      if (tree)
+         multipoint_evaluate(p, xs.data(), out.data(), n);
+      else
+         detail::horner_many(p.data().first, p.size(), xs.data(), out.data(), n);
+      ++reps;
+   } while (clock::now() - start < std::chrono::milliseconds(200));
+   return std::chrono::duration<double, std::micro>(clock::now() - start).count() / reps;
+}
+
+int main() {
+   std::printf("%6s %22s %22s\n", "", "unsigned long long", "double");
+   std::printf("%6s %11s %10s %11s %10s\n", "n", "Horner", "tree", "Horner", "tree");
+   for (int n = 256; n <= 8192; n *= 2)
+      std::printf("%6d %11.1f %10.1f %11.1f %10.1f\n", n,
+                  run<unsigned long long>(n, false), run<unsigned long long>(n, true),
+                  run<double>(n, false), run<double>(n, true));
+}
@@ -0,0 +1,54 @@
+/*  poly_bank::evaluate_all against evaluating each static_poly in turn.
+ *  Build with optimization, e.g.
+ *     g++ -std=c++14 -O2 -I.. poly_bank.cpp -o poly_bank
+ *  and again with -march=native for the wider vector registers.  For 256
+ *  polynomials of 4 to 32 terms it prints the nanoseconds per polynomial
+ *  for each way of evaluating them all at one point.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#include <chrono>
+#include <cstdio>
+#include "../poly_bank.hpp"
+
+const int polys = 256;
+
+template <int N>
+void run() {
+   typedef std::chrono::steady_clock clock;
+   static static_poly<double, N> ps[polys];
+   static poly_bank<double, N, polys> bank;
+   for (int j = 0; j < polys; ++j) {
+      for (int i = 0; i < N; ++i)
+         ps[j][i] = double((i * 7 + j * 3) % 11 - 5) / (i + 1);
+      bank.set(j, ps[j]);
+   }
+   double out[polys];
+   std::printf("%4d", N);
+   for (int banked = 0; banked <= 1; ++banked) {
+      double x = 0.5, sink = 0;
+      int reps = 0;
+      const clock::time_point start = clock::now();
+      do {
+         if (banked)
+            bank.evaluate_all(x, out);
+         else
+            for (int j = 0; j < polys; ++j)
+               out[j] = ps[j](x);
+         sink += out[reps % polys];
+         x += 0 * sink;
+         ++reps;
+      } while (clock::now() - start < std::chrono::milliseconds(100));
+      std::printf(banked ? " %12.2f" : " %7.2f", std::chrono::duration<double, std::nano>(clock::now() - start).count() / reps / polys + 0 * sink);
+   }
+   std::printf("\n");
+}
+
+int main() {
+   std::printf("   N  in turn evaluate_all\n");
+   run<4>();
+   run<8>();
+   run<16>();
+   run<32>();
+}
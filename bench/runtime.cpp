@@ -0,0 +1,176 @@
+/*  Run-time micro-benchmarks of static_poly arithmetic, evaluation and output.
+ *  Build with optimization, e.g.
+ *     g++ -std=c++14 -O2 -I.. runtime.cpp -o runtime
+ *  and run as  ./runtime [operation] [type]  to restrict to names containing
+ *  those strings.  Every operation runs for T = int, long long, double and
+ *  std::complex<double>, with N from 2 to 256 terms, and is reported in
+ *  nanoseconds per operation and millions of operations per second.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#include <chrono>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include "../static_poly_io.hpp"
+
+/* Barriers, so the operands aren't known to the compiler and the results
+ * aren't dropped: everything in static_poly is constexpr, and without these
+ * whole benchmarks fold away at compile time. */
+#if defined(__GNUC__)
+template <class T>
+inline void do_not_optimize(T& value) {
+   asm volatile("" : : "r"(&value) : "memory");
+}
+#else
+template <class T>
+inline void do_not_optimize(T& value) {
+   static volatile const void* sink;
+   sink = &value;
+}
+#endif
+
+/* Coefficients in -2 .. 2, so that products and powers of integers stay small. */
+template <class T>
+T coefficient(int i) {
+   return T((i * 7 + 3) % 5 - 2);
+}
+
+template <>
+std::complex<double> coefficient(int i) {
+   return {double((i * 7 + 3) % 5 - 2), double((i * 3 + 1) % 5 - 2)};
+}
+
+// terms coefficients, then zeros; the leading one is 1
+template <class T, int N>
+static_poly<T, N> sample(int terms) {
+   static_poly<T, N> p;
+   for (int i = 0; i < terms - 1; ++i)
+      p[i] = coefficient<T>(i);
+   p[terms - 1] = T(1);
+   return p;
+}
+
+template <class T> const char* type_name();
+template <> const char* type_name<int>() { return "int"; }
+template <> const char* type_name<long long>() { return "long long"; }
+template <> const char* type_name<double>() { return "double"; }
+template <> const char* type_name<std::complex<double> >() { return "complex<double>"; }
+
+const char* op_filter = "";
+const char* type_filter = "";
+
+/* Times op(), running it in batches until a batch takes long enough to
+ * measure, and reports the best of several batches. */
+template <class Op>
+void run(const char* op_name, const char* type, int n, Op op) {
+   if (!std::strstr(op_name, op_filter) || !std::strstr(type, type_filter))
+      return;
+   typedef std::chrono::steady_clock clock;
+   long reps = 1;
+   for (;;) {
+      const clock::time_point start = clock::now();
+      for (long r = 0; r < reps; ++r)
+         op();
+      if (clock::now() - start > std::chrono::milliseconds(10))
+         break;
+      reps *= 2;
+   }
+   double best = 1e300;
+   for (int batch = 0; batch < 5; ++batch) {
+      const clock::time_point start = clock::now();
+      for (long r = 0; r < reps; ++r)
+         op();
+      const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+      if (ns / reps < best)
+         best = ns / reps;
+   }
+   std::printf("%-20s %-16s %4d %12.1f %12.3f\n", op_name, type, n, best, 1e3 / best);
+}
+
+template <class T, int N>
+void bench_size() {
+   const char* type = type_name<T>();
+
+   {  // p(x), at a point just inside the unit circle so values stay finite
+      const static_poly<T, N> p = sample<T, N>(N);
+      T x = T(1) - T(1) / T(N + 1);
+      run("operator()", type, N, [&] {
+         do_not_optimize(x);
+         T y = p(x);
+         do_not_optimize(y);
+      });
+   }
+   {
+      static_poly<T, N> a = sample<T, N>(N), b = sample<T, N>(N);
+      b[0] = T(3);
+      run("operator*", type, N, [&] {
+         do_not_optimize(a);
+         do_not_optimize(b);
+         auto c = a * b;
+         do_not_optimize(c);
+      });
+   }
+   {  // a product divided by one factor: monic, so integral types divide exactly
+      constexpr int n2 = N / 2 + 1;
+      const static_poly<T, n2> v = sample<T, n2>(n2);
+      static_poly<T, N> u(v * sample<T, N - n2 + 1>(N - n2 + 1));
+      run("quotient_remainder", type, N, [&] {
+         do_not_optimize(u);
+         auto qr = quotient_remainder(u, v);
+         do_not_optimize(qr);
+      });
+   }
+   {
+      static_poly<T, N> p = sample<T, N>(N);
+      run("power<3>", type, N, [&] {
+         do_not_optimize(p);
+         auto c = power<3>(p);
+         do_not_optimize(c);
+      });
+   }
+   {  // half the terms are headroom, as in power<> results
+      static_poly<T, N> p = sample<T, N>((N + 1) / 2);
+      run("degree()", type, N, [&] {
+         do_not_optimize(p);
+         int d = p.degree();
+         do_not_optimize(d);
+      });
+   }
+   {
+      static_poly<T, N> p = sample<T, N>(N);
+      std::ostringstream os;
+      run("operator<<", type, N, [&] {
+         do_not_optimize(p);
+         os.seekp(0);
+         os << p;
+         do_not_optimize(os);
+      });
+   }
+}
+
+template <class T>
+void bench_type() {
+   bench_size<T, 2>();
+   bench_size<T, 4>();
+   bench_size<T, 8>();
+   bench_size<T, 16>();
+   bench_size<T, 32>();
+   bench_size<T, 64>();
+   bench_size<T, 128>();
+   bench_size<T, 256>();
+}
+
+int main(int argc, char* argv[]) {
+   if (argc > 1)
+      op_filter = argv[1];
+   if (argc > 2)
+      type_filter = argv[2];
+   std::printf("%-20s %-16s %4s %12s %12s\n", "operation", "type", "N", "ns/op", "Mop/s");
+   bench_type<int>();
+   bench_type<long long>();
+   bench_type<double>();
+   bench_type<std::complex<double> >();
+}
@@ -0,0 +1,153 @@
+/*  Compensated Horner evaluation: about twice the working precision, with an
+ *  optional rigorous error bound.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_COMPENSATED_HPP
+#define NAM_COMPENSATED_HPP
+
+#include <cmath> // fma, FP_FAST_FMA
+#include <cstddef> // size_t
+#include <limits> // numeric_limits
+#include <type_traits> // integral_constant, is_floating_point
+#include "static_poly.hpp"
+
+/* Nonzero to get the rounding error of products from std::fma (2 operations)
+ * rather than by Dekker's splitting (17).  Defaults to on where the target has
+ * a fast fma.  GCC folds std::fma in constant expressions; other compilers may
+ * need this off for constexpr evaluation. */
+#ifndef NAM_STATIC_POLY_FMA
+#  if defined(FP_FAST_FMA) || defined(__FMA__)
+#    define NAM_STATIC_POLY_FMA 1
+#  else
+#    define NAM_STATIC_POLY_FMA 0
+#  endif
+#endif
+
+/* The value of a polynomial and a bound on its error: the exact value lies
+ * within m_value ± m_bound. */
+template <class T>
+struct bounded_value {
+   T m_value;
+   T m_bound;
+};
+
+namespace detail {
+   /* Error-free transformations (Knuth, Dekker): s + e == a + b and
+    * p + e == a * b exactly, with s and p the rounded results.  These hold in
+    * round to nearest barring overflow (and underflow, for products); they
+    * don't survive -ffast-math. */
+   template <class T>
+   constexpr void two_sum(const T& a, const T& b, T& s, T& e) {
+      s = a + b;
+      const T z = s - a;
+      e = (a - (s - z)) + (b - z);
+   }
+
+   // a = hi + lo, each half of the digits
+   template <class T>
+   constexpr void split(const T& a, T& hi, T& lo) {
+      constexpr int half = (std::numeric_limits<T>::digits + 1) / 2;
+      const T c = (T(1ull << half) + T(1)) * a;
+      hi = c - (c - a);
+      lo = a - hi;
+   }
+
+   template <class T>
+   constexpr void two_product(const T& a, const T& b, T& p, T& e, std::false_type /* no fma */) {
+      p = a * b;
+      T ah {}, al {}, bh {}, bl {};
+      split(a, ah, al);
+      split(b, bh, bl);
+      e = al * bl - (((p - ah * bh) - al * bh) - ah * bl);
+   }
+
+   template <class T>
+   constexpr void two_product(const T& a, const T& b, T& p, T& e, std::true_type /* fma */) {
+      p = a * b;
+      e = std::fma(a, b, -p);
+   }
+
+   template <class T>
+   constexpr void two_product(const T& a, const T& b, T& p, T& e) {
+      typedef std::integral_constant<bool, NAM_STATIC_POLY_FMA && std::is_floating_point<T>::value> fma;
+      two_product(a, b, p, e, fma());
+   }
+
+   /* Horner's rule, collecting the rounding errors of each product and sum
+    * as the coefficients of a second polynomial, which is evaluated alongside
+    * (Graillat, Langlois and Louvet, Algorithms for accurate, validated and
+    * fast polynomial evaluation, 2009).  With `bound`, also Horner's rule on
+    * the magnitudes of those errors at |x|, for the bound of CompHornerBound
+    * there. */
+   template <class T>
+   constexpr bounded_value<T> compensated_horner(const T* a, const T& x, std::size_t count, bool bound) {
+      if (count == 0)
+         return {T(0), T(0)};
+      T s = a[count - 1], r = T(0), alpha = T(0);
+      const T ax = detail::abs(x);
+      for (std::size_t i = count - 1; i > 0;) {
+         --i;
+         T p {}, pi {}, sigma {};
+         two_product(s, x, p, pi);
+         two_sum(p, a[i], s, sigma);
+         r = r * x + (pi + sigma);
+         if (bound)
+            alpha = alpha * ax + (detail::abs(pi) + detail::abs(sigma));
+      }
+      const T value = s + r;
+      if (!bound)
+         return {value, T(0)};
+      // u the unit roundoff, n the degree; exact below are the powers of two
+      const T u = std::numeric_limits<T>::epsilon() / T(2);
+      const T n = T(count - 1);
+      const T k = T(4) * n + T(2), gamma = k * u / (T(1) - k * u);
+      const T av = detail::abs(value);
+      return {value, (u * av + (gamma * alpha + T(2) * u * u * av)) / (T(1) - T(2) * (n + T(1)) * u)};
+   }
+}
+
+/* The polynomial of count coefficients at x, about as accurately as Horner's
+ * rule in twice the precision of T, for floating point T: the result is
+ * within |p(x)| u + O(n² u²) Σ|a_i||x|^i of the true value, u being the unit
+ * roundoff, where Horner's rule gives O(n u) Σ|a_i||x|^i.  That matters near
+ * roots and on ill-conditioned polynomials.  Evaluated one after another it
+ * takes about twice as long as Horner's rule, as long as Horner's rule in
+ * long double (which gains only 11 bits); side by side, where Horner's rule
+ * overlaps evaluations, five to eight times (bench/compensated.cpp). */
+template <class T>
+constexpr T evaluate_compensated(const T* a, const T& x, std::size_t count) {
+   return detail::compensated_horner(a, x, count, false).m_value;
+}
+
+template <std::size_t N, class T>
+constexpr T evaluate_compensated(const T(&a)[N], const T& x) {
+   return detail::compensated_horner(static_cast<const T*>(a), x, N, false).m_value;
+}
+
+template <class T, int N>
+constexpr T evaluate_compensated(const static_poly<T, N>& p, const T& x) {
+   return detail::compensated_horner(p.m_data, x, N, false).m_value;
+}
+
+/* As evaluate_compensated, with a rigorous bound on the error computed along
+ * the way, for about one more multiply-add per term: the exact value is
+ * within m_value ± m_bound, barring underflow and overflow.  When the bound
+ * is too wide for the purpose, fall back on higher precision. */
+template <class T>
+constexpr bounded_value<T> evaluate_compensated_bound(const T* a, const T& x, std::size_t count) {
+   return detail::compensated_horner(a, x, count, true);
+}
+
+template <std::size_t N, class T>
+constexpr bounded_value<T> evaluate_compensated_bound(const T(&a)[N], const T& x) {
+   return detail::compensated_horner(static_cast<const T*>(a), x, N, true);
+}
+
+template <class T, int N>
+constexpr bounded_value<T> evaluate_compensated_bound(const static_poly<T, N>& p, const T& x) {
+   return detail::compensated_horner(p.m_data, x, N, true);
+}
+
+#endif // NAM_COMPENSATED_HPP
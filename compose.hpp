@@ -0,0 +1,158 @@
+/*  Substitution: the Taylor shift p(x + a) and composition p(q(x)).
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_COMPOSE_HPP
+#define NAM_COMPOSE_HPP
+
+#include "static_poly.hpp"
+
+/* From this many terms on, taylor_shift divides and conquers with fast
+ * products; below it, and always for types without them (see use_karatsuba in
+ * multiply.hpp), it goes by repeated synthetic division.  That's where the
+ * run times cross over; constexpr evaluation only breaks even at about 1024
+ * terms. */
+#ifndef NAM_STATIC_POLY_TAYLOR_SHIFT_THRESHOLD
+#  define NAM_STATIC_POLY_TAYLOR_SHIFT_THRESHOLD 256
+#endif
+
+namespace detail {
+   template <class T>
+   constexpr int taylor_shift_threshold() {
+      return use_karatsuba<T>::value ? NAM_STATIC_POLY_TAYLOR_SHIFT_THRESHOLD : (1 << 30);
+   }
+
+   // the least power of two >= n
+   constexpr int ceil_power_of_two(int n) {
+      int p = 1;
+      while (p < n)
+         p *= 2;
+      return p;
+   }
+
+   /* c[0 .. n-1] becomes the coefficients of c(x + a), by Horner's rule on
+    * polynomials: each pass divides by x - a synthetically, and its remainder
+    * is the next coefficient.  n²/2 multiply-adds, in any ring. */
+   template <class T>
+   constexpr void taylor_shift_horner(T* c, int n, const T& a) {
+      for (int i = 0; i + 1 < n; ++i)
+         for (int j = n - 2; j >= i; --j)
+            c[j] += a * c[j + 1];
+   }
+
+   /* The same, dividing and conquering (von zur Gathen and Gerhard, Fast
+    * algorithms for Taylor shifts and certain difference equations, 1997):
+    * blocks of s shifted coefficients combine in pairs as lo + (x + a)^s hi,
+    * for s = 1, 2, 4, ..., with the powers of x + a by squaring.  That's
+    * O(M(n) log n) for products costing M(n).  c has room for Cap >= n terms,
+    * Cap a power of two. */
+   template <int Cap, class T>
+   constexpr void taylor_shift_tree(T* c, int n, const T& a) {
+      T power[Cap] {}, prod[Cap] {};
+      power[0] = a;
+      power[1] = T(1);
+      for (int s = 1; s < n; s *= 2) {
+         for (int off = 0; off + s < n; off += 2 * s) {
+            const int nh = degree_from(c + off + s, std::min(s, n - off - s) - 1) + 1;
+            if (nh == 0)
+               continue;
+            for (int i = 0; i < s + nh; ++i)
+               prod[i] = T(0);
+            mul_trunc<Cap>(power, s + 1, c + off + s, nh, prod, s + nh);
+            for (int i = 0; i < s; ++i)
+               c[off + i] += prod[i];
+            for (int i = s; i < s + nh; ++i)
+               c[off + i] = prod[i];
+         }
+         if (2 * s < n) {
+            for (int i = 0; i <= 2 * s; ++i)
+               prod[i] = T(0);
+            sqr_trunc<Cap>(power, s + 1, prod, 2 * s + 1, use_karatsuba<T>());
+            for (int i = 0; i <= 2 * s; ++i)
+               power[i] = prod[i];
+         }
+      }
+   }
+
+   /* p(q) for p of n terms and q of degree d >= 1, into out[0 .. (n-1)d], by
+    * dividing and conquering as taylor_shift_tree: blocks of s coefficients
+    * of p, each evaluated at q, combine in pairs as lo + q^s hi.  Block j of
+    * size s is kept at buf[j s d]: it has at most (s-1) d + 1 terms.  Cap
+    * bounds the lengths: P d for P >= n a power of two. */
+   template <int Cap, class T>
+   constexpr void compose_tree(const T* p, int n, const T* q, int d, T* out) {
+      T buf[Cap] {}, power[Cap] {}, prod[Cap] {};
+      for (int j = 0; j < n; ++j)
+         buf[j * d] = p[j];
+      for (int i = 0; i <= d; ++i)
+         power[i] = q[i];
+      for (int s = 1; s < n; s *= 2) {
+         const int sd = s * d;
+         for (int off = 0; off + sd < n * d; off += 2 * sd) {
+            const int nh = degree_from(buf + off + sd, std::min((s - 1) * d, (n - 1) * d - off - sd)) + 1;
+            if (nh == 0)
+               continue;
+            for (int i = 0; i < sd + nh; ++i)
+               prod[i] = T(0);
+            mul_trunc<Cap>(power, sd + 1, buf + off + sd, nh, prod, sd + nh);
+            for (int i = 0; i < sd; ++i)
+               buf[off + i] += prod[i];
+            for (int i = sd; i < sd + nh; ++i)
+               buf[off + i] = prod[i];
+         }
+         if (2 * s < n) {
+            for (int i = 0; i <= 2 * sd; ++i)
+               prod[i] = T(0);
+            sqr_trunc<Cap>(power, sd + 1, prod, 2 * sd + 1, use_karatsuba<T>());
+            for (int i = 0; i <= 2 * sd; ++i)
+               power[i] = prod[i];
+         }
+      }
+      for (int i = 0; i <= (n - 1) * d; ++i)
+         out[i] = buf[i];
+   }
+}
+
+/* p(x + a): the coefficients of p's expansion about a, e.g. to recenter an
+ * approximation on the interval it is evaluated on.  By repeated
+ * synthetic division, n²/2 multiply-adds for n terms; from the threshold
+ * (above) on, over types with fast products, by divide and conquer with them:
+ * over long long, two thirds of the time at 512 terms and half at 1024. */
+template <class T, int N>
+constexpr static_poly<T, N> taylor_shift(static_poly<T, N> p, const T& a) {
+   const int n = p.degree() + 1;
+   if (n < detail::taylor_shift_threshold<T>()) {
+      detail::taylor_shift_horner(p.m_data, n, a);
+      return p;
+   }
+   constexpr int P = detail::ceil_power_of_two(N);
+   T c[P] {};
+   for (int i = 0; i < n; ++i)
+      c[i] = p[i];
+   detail::taylor_shift_tree<P>(c, n, a);
+   for (int i = 0; i < n; ++i)
+      p[i] = c[i];
+   return p;
+}
+
+/* p(q(x)), of degree up to (N1 - 1)(N2 - 1).  By divide and conquer with
+ * the library's products: O(M(nd) log n) for p of n terms and q of degree d,
+ * where Horner's rule on polynomials, p_{n-1} q + p_{n-2}, and so on, costs
+ * n products of up to nd terms by q's d + 1. */
+template <class T, int N1, int N2>
+constexpr static_poly<T, (N1 - 1) * (N2 - 1) + 1> compose(const static_poly<T, N1>& p, const static_poly<T, N2>& q) {
+   static_poly<T, (N1 - 1) * (N2 - 1) + 1> out;
+   const int n = p.degree() + 1, d = q.degree();
+   if (n == 0)
+      return out;
+   if (d < 1) { // q is a constant, or zero
+      out[0] = evaluate_polynomial(p.m_data, q[0], n);
+      return out;
+   }
+   constexpr int Cap = detail::ceil_power_of_two(N1) * std::max(N2 - 1, 1) + 1;
+   detail::compose_tree<Cap>(p.m_data, n, q.m_data, d, out.m_data);
+   return out;
+}
+
+#endif // NAM_COMPOSE_HPP
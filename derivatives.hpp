@@ -0,0 +1,286 @@
+/*  Derivatives and integrals of compile-time sized polynomials, and the value
+ *  and first derivatives at a point in one pass.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_DERIVATIVES_HPP
+#define NAM_DERIVATIVES_HPP
+
+#include <cassert>
+#include <cstddef> // size_t
+#include <limits> // numeric_limits
+#include <type_traits> // integral_constant
+#include "static_poly.hpp"
+#include "evaluate_many.hpp" // lanes, simd_lanes
+
+/* The k-th derivative of p, of N - k terms (one, zero, if k >= N). */
+template <int k = 1, class T, int N>
+constexpr static_poly<T, (k < N ? N - k : 1)> derivative(const static_poly<T, N>& p) {
+   static_assert(k >= 0, "Negative order of derivative");
+   static_poly<T, (k < N ? N - k : 1)> d;
+   for (int i = 0; i + k < N; ++i) {
+      T c = p[i + k];
+      for (int m = 1; m <= k; ++m)
+         c *= T(i + m);
+      d[i] = c;
+   }
+   return d;
+}
+
+/* The antiderivative of p that vanishes at 0, of N + 1 terms.  The terms are
+ * divided by 1, 2, ..., N, so T should be a field; over exact types such as
+ * the integers, the divisions are asserted to be exact. */
+template <class T, int N>
+constexpr static_poly<T, N + 1> integral(const static_poly<T, N>& p) {
+   static_poly<T, N + 1> q;
+   for (int i = 0; i < N; ++i) {
+      q[i + 1] = p[i] / T(i + 1);
+      assert(!std::numeric_limits<T>::is_exact || q[i + 1] * T(i + 1) == p[i]);
+   }
+   return q;
+}
+
+/* p(x), p'(x), ..., p^(K)(x) for some p and x. */
+template <class V, int K>
+struct derivative_values {
+   V m_values[K + 1];
+
+   // typedefs:
+   typedef V value_type;
+   typedef int size_type;
+
+   constexpr size_type size() const {
+      return K + 1;
+   }
+
+   constexpr V& operator[] (size_type k) {
+      return m_values[k];
+   }
+
+   constexpr const V& operator[] (size_type k) const {
+      return m_values[k];
+   }
+};
+
+namespace detail {
+   /* One step of Horner's rule on the Taylor coefficients at x, unrolled:
+    * d[j] = d[j] x + d[j - 1] for j = J, ..., 1, then d[0] = d[0] x + c.  This
+    * divides the polynomial so far by (y - x) repeatedly in the same pass. */
+   template <class V, class T>
+   constexpr void taylor_step(V* d, const V& x, const T& c, int_tag<0>) {
+      d[0] = d[0] * x + c;
+   }
+
+   template <class V, class T, int J>
+   constexpr void taylor_step(V* d, const V& x, const T& c, int_tag<J>) {
+      d[J] = d[J] * x + d[J - 1];
+      taylor_step(d, x, c, make_int_tag<J - 1>());
+   }
+
+   // as taylor_step, but d[J] is new, so it's set to d[J - 1]
+   template <class V, class T, int J>
+   constexpr void taylor_step(V* d, const V& x, const T& c, int_tag<J>, std::true_type /* new */) {
+      d[J] = d[J - 1];
+      taylor_step(d, x, c, make_int_tag<J - 1>());
+   }
+
+   /* The first steps, S = 1, ..., min(K, N - 1), for a[(N - 1 - S) Step], of
+    * a[0], a[Step], ... (N terms): each brings in the next coefficient, d[S],
+    * which is set rather than updated, and those above it, still zero, are
+    * left alone. */
+   template <int N, int K, int Step, int S, class T, class V>
+   constexpr void taylor_ramp(const T*, const V&, V*, std::false_type /* S > min(K, N - 1) */) {}
+
+   template <int N, int K, int Step, int S, class T, class V>
+   constexpr void taylor_ramp(const T* a, const V& x, V* d, std::true_type) {
+      taylor_step(d, x, a[(N - 1 - S) * Step], make_int_tag<S>(), std::true_type());
+      taylor_ramp<N, K, Step, S + 1>(a, x, d, std::integral_constant<bool, (S < K && S + 1 < N)>());
+   }
+
+   // the steps after those, for a[I Step], ..., a[0], all alike, unrolled
+   template <int K, int Step, int I, class T, class V>
+   constexpr void taylor_steps(const T*, const V&, V*, std::false_type /* I < 0 */) {}
+
+   template <int K, int Step, int I, class T, class V>
+   constexpr void taylor_steps(const T* a, const V& x, V* d, std::true_type) {
+      taylor_step(d, x, a[I * Step], make_int_tag<K>());
+      taylor_steps<K, Step, I - 1>(a, x, d, std::integral_constant<bool, (I > 0)>());
+   }
+
+   // or a loop, past NAM_STATIC_POLY_UNROLL_LIMIT of them, as horner_chain
+   template <int I, int K, int Step, class T, class V>
+   constexpr void taylor_rest(const T* a, const V& x, V* d, std::false_type) {
+      taylor_steps<K, Step, I>(a, x, d, std::integral_constant<bool, (I >= 0)>());
+   }
+
+   template <int I, int K, int Step, class T, class V>
+   constexpr void taylor_rest(const T* a, const V& x, V* d, std::true_type /* loop */) {
+      for (int i = I; i >= 0; --i)
+         taylor_step(d, x, a[i * Step], make_int_tag<K>());
+   }
+
+   /* The Taylor coefficients at x, p^(k)(x) / k! for k <= K, of a[0],
+    * a[Step], ... (N > 0 terms) into d, which is zero: K + 1 interleaved
+    * Horner chains, each a step behind the last (Shaw and Traub, On the
+    * number of multiplications for the evaluation of a polynomial and some
+    * of its derivatives, 1974).  The chains overlap, for a latency of about
+    * N + K multiply-adds. */
+   template <int N, int K, int Step, class T, class V>
+   constexpr void taylor_coefficients(const T* a, const V& x, V* d) {
+      constexpr int I = N - 2 - K; // the last steps are for a[I Step], ..., a[0]
+      d[0] = V(a[(N - 1) * Step]);
+      taylor_ramp<N, K, Step, 1>(a, x, d, std::integral_constant<bool, (K > 0 && N > 1)>());
+      taylor_rest<I, K, Step>(a, x, d, std::integral_constant<bool, (I >= NAM_STATIC_POLY_UNROLL_LIMIT)>());
+   }
+
+   // r times 2xh + h², modulo h^(M+1), unrolled
+   template <class V>
+   constexpr void delta_step(V*, const V&, int_tag<0>) {}
+
+   template <class V>
+   constexpr void delta_step(V* r, const V& x2, int_tag<1>) {
+      r[1] = x2 * r[0];
+      r[0] = V(0);
+   }
+
+   template <class V, int M>
+   constexpr void delta_step(V* r, const V& x2, int_tag<M>) {
+      r[M] = x2 * r[M - 1] + r[M - 2];
+      delta_step(r, x2, make_int_tag<M - 1>());
+   }
+
+   // d[m] = r[m] + s[m] x + s[m - 1] for m = M, ..., 0, unrolled
+   template <class V>
+   constexpr void odd_step(V* d, const V* r, const V* s, const V& x, int_tag<0>) {
+      d[0] = r[0] + s[0] * x;
+   }
+
+   template <class V, int M>
+   constexpr void odd_step(V* d, const V* r, const V* s, const V& x, int_tag<M>) {
+      d[M] = r[M] + s[M] * x + s[M - 1];
+      odd_step(d, r, s, x, make_int_tag<M - 1>());
+   }
+
+   /* The same by the second order Horner rule.  With e and o the even and odd
+    * parts of p, p(x + h) = e(y + δ) + (x + h) o(y + δ), for y = x² and
+    * δ = 2xh + h²: so two passes of half the length give the Taylor
+    * coefficients of e and o at y, and Horner's rule in δ on those, modulo
+    * h^(K+1), gives p's, for about K² more multiply-adds. */
+   template <int N, int K, class T, class V>
+   constexpr void taylor_coefficients2(const T* a, const V& x, V* d) {
+      constexpr int J = K < (N - 1) / 2 ? K : (N - 1) / 2; // the top Taylor coefficient of e
+      const V y = x * x, x2 = x + x;
+      V e[K + 1] {}, o[K + 1] {};
+      taylor_coefficients<(N + 1) / 2, K, 2>(a, y, e);
+      taylor_coefficients<N / 2, K, 2>(a + 1, y, o);
+      V r[K + 1] {}, s[K + 1] {};
+      r[0] = e[J];
+      s[0] = o[J];
+      for (int j = J - 1; j >= 0; --j) {
+         delta_step(r, x2, make_int_tag<K>());
+         delta_step(s, x2, make_int_tag<K>());
+         r[0] = e[j];
+         s[0] = o[j];
+      }
+      odd_step(d, r, s, x, make_int_tag<K>());
+   }
+
+   template <int N, int K, class T, class V>
+   constexpr void taylor_coefficients(const T* a, const V& x, V* d, std::false_type /* N < 5 */) {
+      taylor_coefficients<N, K, 1>(a, x, d);
+   }
+
+   template <int N, int K, class T, class V>
+   constexpr void taylor_coefficients(const T* a, const V& x, V* d, std::true_type) {
+      taylor_coefficients2<N, K>(a, x, d);
+   }
+
+   // d[k] *= k! for k = M, ..., 2, unrolled
+   template <class V>
+   constexpr V factorial_step(V*, int_tag<1>) {
+      return V(1);
+   }
+
+   template <class V, int M>
+   constexpr V factorial_step(V* d, int_tag<M>) {
+      const V f = factorial_step(d, make_int_tag<M - 1>()) * V(M);
+      d[M] *= f;
+      return f;
+   }
+
+   template <class V>
+   constexpr V factorial_step(V*, int_tag<0>) {
+      return V(1);
+   }
+
+   /* p^(k)(x) for k <= K, from the Taylor coefficients, by the same rule as
+    * evaluate_polynomial: Horner's up to four terms, second order beyond. */
+   template <int K, int N, class T, class V>
+   constexpr derivative_values<V, K> evaluate_derivatives(const T* a, const V& x) {
+      derivative_values<V, K> d {};
+      if (N == 0)
+         return d;
+      taylor_coefficients<N, K>(a, x, d.m_values, std::integral_constant<bool, (N >= 5)>());
+      factorial_step(d.m_values, make_int_tag<(K < N - 1 ? K : N - 1)>());
+      return d;
+   }
+}
+
+/* The value of p and its first K derivatives at x in one pass, e.g. p and p'
+ * for a Newton step (K = 1) or p, p' and p'' for Halley's:
+ *    const auto d = evaluate_with_derivatives<1>(p, x);
+ *    x -= d[0] / d[1];
+ * Derivatives of order N and above are zero. */
+template <int K, class T, int N, class V>
+constexpr derivative_values<V, K> evaluate_with_derivatives(const static_poly<T, N>& p, const V& x) {
+   static_assert(K >= 0, "Negative order of derivative");
+   return detail::evaluate_derivatives<K, N>(p.m_data, x);
+}
+
+template <int K, std::size_t N, class T, class V>
+constexpr derivative_values<V, K> evaluate_with_derivatives(const T(&a)[N], const V& x) {
+   static_assert(K >= 0, "Negative order of derivative");
+   return detail::evaluate_derivatives<K, int(N)>(static_cast<const T*>(a), x);
+}
+
+namespace detail {
+   template <int K, int N, class T, class V, int W>
+   void evaluate_derivatives_many_imp(const T* a, const V* xs, derivative_values<V, K>* out,
+                                      std::size_t n, const std::integral_constant<int, W>*) {
+      const std::size_t blocked = n - n % W;
+      std::size_t i = 0;
+      for (; i < blocked; i += W) {
+         lanes<V, W> x;
+         for (int l = 0; l < W; ++l)
+            x.set(l, xs[i + l]);
+         const derivative_values<lanes<V, W>, K> d = evaluate_derivatives<K, N>(a, x);
+         for (int l = 0; l < W; ++l)
+            for (int k = 0; k <= K; ++k)
+               out[i + l][k] = d[k][l];
+      }
+      for (; i < n; ++i) // scalar tail
+         out[i] = evaluate_derivatives<K, N>(a, xs[i]);
+   }
+
+   // scalar fallback
+   template <int K, int N, class T, class V>
+   void evaluate_derivatives_many_imp(const T* a, const V* xs, derivative_values<V, K>* out,
+                                      std::size_t n, const std::integral_constant<int, 1>*) {
+      for (std::size_t i = 0; i < n; ++i)
+         out[i] = evaluate_derivatives<K, N>(a, xs[i]);
+   }
+}
+
+/* evaluate_with_derivatives<K>(p, xs[i]) into out[i] for i < n, a vector
+ * register's worth of points at a time as evaluate_many does, with the same
+ * results. */
+template <int K, class T, int N>
+void evaluate_with_derivatives_many(const static_poly<T, N>& p, const T* xs,
+                                    derivative_values<T, K>* out, std::size_t n) {
+   static_assert(K >= 0, "Negative order of derivative");
+   typedef std::integral_constant<int, detail::simd_lanes<T>()> tag_type;
+   detail::evaluate_derivatives_many_imp<K, N>(p.m_data, xs, out, n, static_cast<tag_type const*>(0));
+}
+
+#endif // NAM_DERIVATIVES_HPP
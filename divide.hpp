@@ -0,0 +1,107 @@
+//  Division kernels on coefficient arrays, shared by the polynomial types.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NAM_POLYNOMIAL_DIVIDE_HPP
+#define NAM_POLYNOMIAL_DIVIDE_HPP
+
+#include <type_traits> // is_integral
+#include "multiply.hpp"
+
+/* Both the quotient and the divisor need at least this many terms before
+ * division by Newton iteration is used in place of long division.  Integral
+ * long division is pseudo-division, which rescales the whole remainder at each
+ * step, so Newton pays off much sooner there than over a field. */
+#ifndef NAM_STATIC_POLY_NEWTON_DIVISION_THRESHOLD
+#  define NAM_STATIC_POLY_NEWTON_DIVISION_THRESHOLD 32
+#endif
+
+#ifndef NAM_STATIC_POLY_NEWTON_FIELD_DIVISION_THRESHOLD
+#  define NAM_STATIC_POLY_NEWTON_FIELD_DIVISION_THRESHOLD 256
+#endif
+
+namespace detail {
+
+constexpr int newton_division_threshold = NAM_STATIC_POLY_NEWTON_DIVISION_THRESHOLD;
+constexpr int newton_field_division_threshold = NAM_STATIC_POLY_NEWTON_FIELD_DIVISION_THRESHOLD;
+
+constexpr int min_of(int a, int b) {
+   return a < b ? a : b;
+}
+
+// 1/x, where over an integral type x is 1 or -1, hence its own inverse
+template <class T>
+constexpr T inverse(const T& x, std::false_type) {
+   return T(1) / x;
+}
+
+template <class T>
+constexpr T inverse(const T& x, std::true_type /* integral */) {
+   return x;
+}
+
+/* g[0 .. len-1] = the power series 1/f modulo x^len, where f has nf terms and
+ * f[0] is invertible.  prod needs 2 len terms and scratch mul_scratch(len).
+ * Newton's iteration g <- g (2 - f g) doubles the number of correct terms each
+ * step; as f g = 1 + O(x^k) for the first k terms, only the new terms are
+ * computed: g[k .. 2k-1] = -g (f g)[k .. 2k-1]. */
+template <class T>
+constexpr void reciprocal_series(const T* f, int nf, T* g, int len, T* prod, T* scratch) {
+   g[0] = inverse(f[0], std::is_integral<T>());
+   for (int k = 1; k < len; k *= 2) {
+      const int k2 = min_of(2 * k, len), na = min_of(nf, k2);
+      mul_general(f, na, g, k, prod, scratch);
+      for (int i = k; i < k2; ++i) // the error terms go where the new terms will be
+         g[i] = i < na + k - 1 ? prod[i] : T(0);
+      mul_general(g, k2 - k, g + k, k2 - k, prod, scratch);
+      for (int i = 0; i < k2 - k; ++i)
+         g[k + i] = -prod[i];
+   }
+}
+
+/* The coefficient type newton_divide works in for T, modular_ring<T>: the
+ * power series 1/rev(v) can outgrow T even when the quotient doesn't, and
+ * arithmetic modulo 2^bits still ends with the exact quotient and remainder
+ * when they fit in T. */
+template <class T>
+struct newton_ring : modular_ring<T> {};
+
+/* Scratch space needed by newton_divide for dividends of up to n terms. */
+constexpr int newton_division_scratch(int n) {
+   return 5 * n + mul_scratch(n);
+}
+
+/* Quotient q[0 .. nu-nv] and remainder r[0 .. nv-2] of u[0 .. nu-1] by
+ * v[0 .. nv-1], where nu >= nv > 1 and v[nv-1] is invertible, using
+ * newton_division_scratch(nu) of scratch.
+ * With rev(p) the polynomial p with its coefficients reversed, the quotient is
+ * rev(rev(u) / rev(v) modulo x^(nu-nv+1)), where the power series 1/rev(v)
+ * comes from Newton iteration; the work is a few multiplications, so with
+ * Karatsuba this beats the O(nu nv) of long division for large sizes. */
+template <class T>
+constexpr void newton_divide(const T* u, int nu, const T* v, int nv, T* q, T* r, T* scratch) {
+   const int nq = nu - nv + 1, nf = min_of(nv, nq);
+   T* rev_v = scratch;
+   T* g = rev_v + nq;
+   T* rev_u = g + nq;
+   T* prod = rev_u + nq;
+   T* rest = prod + 2 * nu;
+   for (int i = 0; i < nf; ++i)
+      rev_v[i] = v[nv - 1 - i];
+   for (int i = 0; i < nq; ++i)
+      rev_u[i] = u[nu - 1 - i];
+   reciprocal_series(rev_v, nf, g, nq, prod, rest);
+   mul_general(rev_u, nq, g, nq, prod, rest);
+   for (int i = 0; i < nq; ++i)
+      q[i] = prod[nq - 1 - i];
+   // r = u - q v, of which only the terms below x^(nv-1) are left
+   const int nr = nv - 1;
+   mul_general(q, min_of(nq, nr), v, nr, prod, rest);
+   for (int i = 0; i < nr; ++i)
+      r[i] = u[i] - (i < min_of(nq, nr) + nr - 1 ? prod[i] : T(0));
+}
+
+} // namespace detail
+
+#endif // NAM_POLYNOMIAL_DIVIDE_HPP
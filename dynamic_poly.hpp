@@ -0,0 +1,573 @@
+/*  Polynomials whose size is chosen at run time.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_DYNAMIC_POLY_HPP
+#define NAM_DYNAMIC_POLY_HPP
+
+#include <cassert>
+#include <algorithm> // max, min
+#include <initializer_list>
+#include <memory> // allocator, allocator_traits
+#include <type_traits> // is_integral
+#include <utility> // pair, swap
+#include "static_poly.hpp"
+
+/* Coefficients a dynamic_poly holds in place, before it goes to the heap. */
+#ifndef NAM_DYNAMIC_POLY_SMALL_SIZE
+#  define NAM_DYNAMIC_POLY_SMALL_SIZE 8
+#endif
+
+namespace detail {
+   /* n value-initialized T from alloc (rebound to T), freed at the end of the
+    * scope: scratch space for the kernels. */
+   template <class T, class Alloc>
+   struct dynamic_buffer {
+      typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T> alloc_type;
+      typedef std::allocator_traits<alloc_type> traits;
+
+      alloc_type alloc;
+      T* data;
+      int n;
+
+      dynamic_buffer(const Alloc& a, int n)
+      : alloc(a), data(n ? traits::allocate(alloc, n) : nullptr), n(n) {
+         for (int i = 0; i < n; ++i)
+            traits::construct(alloc, data + i);
+      }
+
+      ~dynamic_buffer() {
+         for (int i = 0; i < n; ++i)
+            traits::destroy(alloc, data + i);
+         if (n)
+            traits::deallocate(alloc, data, n);
+      }
+
+      dynamic_buffer(const dynamic_buffer&) = delete;
+      dynamic_buffer& operator =(const dynamic_buffer&) = delete;
+   };
+
+   /* out[0 .. na+nb-2] = a * b, where out starts zero.  As detail::mul_trunc,
+    * but with the Karatsuba scratch from alloc; the number theoretic transform
+    * needs its buffers sized at compile time, and is left to static_poly. */
+   template <class T, class Alloc>
+   void mul_dynamic(const T* a, int na, const T* b, int nb, T* out, const Alloc& alloc, std::true_type) {
+      if (na < karatsuba_threshold || nb < karatsuba_threshold)
+         return mul_schoolbook(a, na, b, nb, out);
+      dynamic_buffer<T, Alloc> scratch(alloc, mul_scratch(std::max(na, nb)));
+      mul_general(a, na, b, nb, out, scratch.data);
+   }
+
+   template <class T, class Alloc>
+   void mul_dynamic(const T* a, int na, const T* b, int nb, T* out, const Alloc&, std::false_type) {
+      for (int i = 0; i < na; ++i)
+         for (int j = 0; j < nb; ++j)
+            out[i+j] += a[i] * b[j];
+   }
+
+   // out[0 .. 2na-2] = a * a, where out starts zero
+   template <class T, class Alloc>
+   void sqr_dynamic(const T* a, int na, T* out, const Alloc& alloc, std::true_type) {
+      if (na < karatsuba_threshold)
+         return sqr_schoolbook(a, na, out, 2*na - 1);
+      dynamic_buffer<T, Alloc> scratch(alloc, karatsuba_scratch(na));
+      sqr_karatsuba(a, na, out, scratch.data);
+   }
+
+   template <class T, class Alloc>
+   void sqr_dynamic(const T* a, int na, T* out, const Alloc& alloc, std::false_type) {
+      mul_dynamic(a, na, a, na, out, alloc, std::false_type());
+   }
+}
+
+/* A polynomial with coefficients in T, of any degree, and the same operations
+ * as static_poly, by the same kernels.  Up to NAM_DYNAMIC_POLY_SMALL_SIZE
+ * coefficients are kept in the object; more come from Alloc.  Storage is
+ * reused: assignment, the compound operators, multiply(), square() and
+ * quotient_remainder() with output arguments only allocate to grow, and
+ * operators on temporaries work in the temporary.
+ * The size is always the degree + 1, so the top coefficient is nonzero, and
+ * m_data[m_size .. m_capacity-1] are zero. */
+template <class T, class Alloc = std::allocator<T> >
+struct dynamic_poly {
+   typedef std::allocator_traits<Alloc> traits;
+
+   T* m_data; // m_small, or m_capacity elements from m_alloc
+   int m_size;
+   int m_capacity;
+   Alloc m_alloc;
+   T m_small[NAM_DYNAMIC_POLY_SMALL_SIZE];
+
+   // typedefs:
+   typedef T value_type;
+   typedef int size_type;
+   typedef Alloc allocator_type;
+
+   // construct:
+   explicit dynamic_poly(const Alloc& alloc = Alloc())
+   : m_data(m_small), m_size(0), m_capacity(NAM_DYNAMIC_POLY_SMALL_SIZE), m_alloc(alloc), m_small{} {}
+
+   template <class It>
+   dynamic_poly(It first, It last, const Alloc& alloc = Alloc()) : dynamic_poly(alloc) {
+      for (int i = 0; first != last; ++i, ++first) {
+         grow(i + 1);
+         m_data[i] = *first;
+         m_size = i + 1;
+      }
+      normalize();
+   }
+
+   dynamic_poly(std::initializer_list<T> l, const Alloc& alloc = Alloc())
+   : dynamic_poly(std::begin(l), std::end(l), alloc) {}
+
+   template <class U>
+   explicit dynamic_poly(const U& point, const Alloc& alloc = Alloc()) : dynamic_poly(alloc) {
+      m_data[0] = point;
+      m_size = 1;
+      normalize();
+   }
+
+   template <class U, int N>
+   explicit dynamic_poly(const static_poly<U, N>& p, const Alloc& alloc = Alloc())
+   : dynamic_poly(p.m_data, p.m_data + p.degree() + 1, alloc) {}
+
+   dynamic_poly(const dynamic_poly& p)
+   : dynamic_poly(traits::select_on_container_copy_construction(p.m_alloc)) {
+      *this = p;
+   }
+
+   // takes the heap storage of p, or copies its small buffer
+   dynamic_poly(dynamic_poly&& p) : dynamic_poly(p.m_alloc) {
+      *this = std::move(p);
+   }
+
+   ~dynamic_poly() {
+      release();
+   }
+
+   dynamic_poly& operator =(const dynamic_poly& p) {
+      if (this == &p)
+         return *this;
+      grow(p.m_size, false);
+      for (int i = 0; i < p.m_size; ++i)
+         m_data[i] = p.m_data[i];
+      for (int i = p.m_size; i < m_size; ++i)
+         m_data[i] = T(0);
+      m_size = p.m_size;
+      return *this;
+   }
+
+   dynamic_poly& operator =(dynamic_poly&& p) {
+      if (this == &p)
+         return *this;
+      if (p.m_data != p.m_small && m_alloc == p.m_alloc) {
+         release();
+         m_data = p.m_data;
+         m_size = p.m_size;
+         m_capacity = p.m_capacity;
+         p.m_data = p.m_small;
+         p.m_capacity = NAM_DYNAMIC_POLY_SMALL_SIZE;
+         p.m_size = 0;
+         for (T& t : p.m_small) // left over from before p grew
+            t = T(0);
+         return *this;
+      }
+      *this = static_cast<const dynamic_poly&>(p);
+      p.clear();
+      return *this;
+   }
+
+   // if N is smaller than the size, we lose the high terms, as static_poly's conversions do
+   template <int N>
+   static_poly<T, N> to_static() const {
+      return static_poly<T, N>(m_data, m_data + m_size);
+   }
+
+   // access:
+   size_type size() const {
+      return m_size;
+   }
+
+   size_type degree() const {
+      return m_size - 1;
+   }
+
+   size_type capacity() const {
+      return m_capacity;
+   }
+
+   allocator_type get_allocator() const {
+      return m_alloc;
+   }
+
+   void reserve(size_type n) {
+      grow(n);
+   }
+
+   const T& operator[] (size_type i) const {
+      assert(i >= 0 && i < m_size);
+      return m_data[i];
+   }
+
+   void set(size_type i, const T& value) {
+      if (i >= m_size) {
+         if (value == T{0})
+            return;
+         grow(i + 1);
+         m_size = i + 1;
+      }
+      m_data[i] = value;
+      normalize();
+   }
+
+   // to zero, keeping the storage
+   void clear() {
+      for (int i = 0; i < m_size; ++i)
+         m_data[i] = T(0);
+      m_size = 0;
+   }
+
+   T operator() (T z) const {
+      return evaluate_polynomial(m_data, z, m_size);
+   }
+
+   std::pair<const T*, const T*> data() const {
+      return std::make_pair(m_data, m_data + m_size);
+   }
+
+   // operators:
+   template <class U>
+   dynamic_poly& operator +=(const U& value) {
+      m_data[0] += value; // there's always room for one
+      m_size = std::max(m_size, 1);
+      normalize();
+      return *this;
+   }
+
+   template <class U>
+   dynamic_poly& operator -=(const U& value) {
+      m_data[0] -= value;
+      m_size = std::max(m_size, 1);
+      normalize();
+      return *this;
+   }
+
+   template <class U>
+   dynamic_poly& operator *=(const U& value) {
+      for (int i = 0; i < m_size; ++i)
+         m_data[i] *= value;
+      normalize();
+      return *this;
+   }
+
+   template <class U>
+   dynamic_poly& operator /=(const U& value) {
+      for (int i = 0; i < m_size; ++i)
+         m_data[i] /= value;
+      normalize();
+      return *this;
+   }
+
+   template <class U>
+   dynamic_poly& operator %=(const U& value) {
+      // as static_poly::operator%=
+      if (std::is_integral<T>::value) {
+         for (int i = 0; i < m_size; ++i)
+            m_data[i] -= T(value * T(m_data[i] / value));
+         normalize();
+      } else {
+         clear();
+      }
+      return *this;
+   }
+
+   dynamic_poly& operator +=(const dynamic_poly& p) {
+      grow(p.m_size);
+      for (int i = 0; i < p.m_size; ++i)
+         m_data[i] += p.m_data[i];
+      m_size = std::max(m_size, p.m_size);
+      normalize();
+      return *this;
+   }
+
+   dynamic_poly& operator -=(const dynamic_poly& p) {
+      grow(p.m_size);
+      for (int i = 0; i < p.m_size; ++i)
+         m_data[i] -= p.m_data[i];
+      m_size = std::max(m_size, p.m_size);
+      normalize();
+      return *this;
+   }
+
+   dynamic_poly& operator *=(const dynamic_poly& p) {
+      dynamic_poly prod(m_alloc);
+      multiply(*this, p, prod);
+      return *this = std::move(prod);
+   }
+
+   explicit operator bool() const {
+      return m_size > 0;
+   }
+
+   // storage:
+   // drops the zero high terms
+   void normalize() {
+      m_size = detail::degree_from(m_data, m_size - 1) + 1;
+   }
+
+   // room for n coefficients, keeping the present ones if keep
+   void grow(int n, bool keep = true) {
+      if (n <= m_capacity)
+         return;
+      const int capacity = std::max(n, 2 * m_capacity);
+      T* data = traits::allocate(m_alloc, capacity);
+      for (int i = 0; i < capacity; ++i)
+         traits::construct(m_alloc, data + i);
+      if (keep)
+         for (int i = 0; i < m_size; ++i)
+            data[i] = m_data[i];
+      else
+         m_size = 0;
+      release();
+      m_data = data;
+      m_capacity = capacity;
+   }
+
+   void release() {
+      if (m_data == m_small)
+         return;
+      for (int i = 0; i < m_capacity; ++i)
+         traits::destroy(m_alloc, m_data + i);
+      traits::deallocate(m_alloc, m_data, m_capacity);
+      m_data = m_small;
+      m_capacity = NAM_DYNAMIC_POLY_SMALL_SIZE;
+      for (T& t : m_small)
+         t = T(0);
+   }
+};
+
+template <class T, class Alloc>
+void swap(dynamic_poly<T, Alloc>& a, dynamic_poly<T, Alloc>& b) {
+   dynamic_poly<T, Alloc> t(std::move(a));
+   a = std::move(b);
+   b = std::move(t);
+}
+
+/* out = a * b, in the storage of out, which must be neither a nor b. */
+template <class T, class Alloc>
+void multiply(const dynamic_poly<T, Alloc>& a, const dynamic_poly<T, Alloc>& b, dynamic_poly<T, Alloc>& out) {
+   assert(&out != &a && &out != &b);
+   out.clear();
+   if (!a || !b) // a or b is zero
+      return;
+   const int n = a.m_size + b.m_size - 1;
+   out.grow(n, false);
+   detail::mul_dynamic(a.m_data, a.m_size, b.m_data, b.m_size, out.m_data, out.m_alloc,
+                       detail::use_karatsuba<T>());
+   out.m_size = n;
+   out.normalize();
+}
+
+/* out = a * a, in the storage of out, which must not be a. */
+template <class T, class Alloc>
+void square(const dynamic_poly<T, Alloc>& a, dynamic_poly<T, Alloc>& out) {
+   assert(&out != &a);
+   out.clear();
+   if (!a)
+      return;
+   const int n = 2 * a.m_size - 1;
+   out.grow(n, false);
+   detail::sqr_dynamic(a.m_data, a.m_size, out.m_data, out.m_alloc, detail::use_karatsuba<T>());
+   out.m_size = n;
+   out.normalize();
+}
+
+/* q = u / v and r = u % v, as quotient_remainder on static_polys computes
+ * them, in the storage of q and r.  Neither may be v, and q may not be u.
+ * This function is not defined for division by zero: user beware.
+ */
+template <class T, class Alloc>
+void quotient_remainder(const dynamic_poly<T, Alloc>& u, const dynamic_poly<T, Alloc>& v,
+                        dynamic_poly<T, Alloc>& q, dynamic_poly<T, Alloc>& r) {
+   assert(v);
+   assert(&q != &u && &q != &v && &r != &v && &q != &r);
+   const int m = u.degree(), n = v.degree();
+   q.clear();
+   if (m < n) {
+      r = u;
+      return;
+   }
+   q.grow(m - n + 1, false);
+   if (detail::use_newton_division(v[n], m - n + 1, n + 1, std::is_integral<T>())) {
+      typedef typename detail::newton_ring<T>::type R;
+      detail::dynamic_buffer<R, Alloc> ur(u.m_alloc, m + 1), vr(u.m_alloc, n + 1),
+                                       qr(u.m_alloc, m - n + 1), rr(u.m_alloc, n),
+                                       scratch(u.m_alloc, detail::newton_division_scratch(m + 1));
+      for (int i = 0; i <= m; ++i)
+         ur.data[i] = static_cast<R>(u.m_data[i]);
+      for (int i = 0; i <= n; ++i)
+         vr.data[i] = static_cast<R>(v.m_data[i]);
+      detail::newton_divide(ur.data, m + 1, vr.data, n + 1, qr.data, rr.data, scratch.data);
+      for (int i = 0; i <= m - n; ++i)
+         q.m_data[i] = static_cast<T>(qr.data[i]);
+      r.clear();
+      r.grow(n, false);
+      for (int i = 0; i < n; ++i)
+         r.m_data[i] = static_cast<T>(rr.data[i]);
+   } else {
+      r = u; // divided in place
+      detail::long_division(q.m_data, r.m_data, v.m_data, m, n);
+   }
+   q.m_size = m - n + 1;
+   q.normalize();
+   r.m_size = n;
+   r.normalize();
+}
+
+template <class T, class Alloc>
+std::pair< dynamic_poly<T, Alloc>, dynamic_poly<T, Alloc> >
+quotient_remainder(const dynamic_poly<T, Alloc>& dividend, const dynamic_poly<T, Alloc>& divisor) {
+   dynamic_poly<T, Alloc> q(dividend.get_allocator()), r(dividend.get_allocator());
+   quotient_remainder(dividend, divisor, q, r);
+   return std::make_pair(std::move(q), std::move(r));
+}
+
+template <class T, class Alloc, class U>
+dynamic_poly<T, Alloc> operator + (dynamic_poly<T, Alloc> a, const U& b) {
+   return std::move(a += b);
+}
+
+template <class T, class Alloc, class U>
+dynamic_poly<T, Alloc> operator - (dynamic_poly<T, Alloc> a, const U& b) {
+   return std::move(a -= b);
+}
+
+template <class T, class Alloc, class U>
+dynamic_poly<T, Alloc> operator * (dynamic_poly<T, Alloc> a, const U& b) {
+   return std::move(a *= b);
+}
+
+template <class T, class Alloc, class U>
+dynamic_poly<T, Alloc> operator / (dynamic_poly<T, Alloc> a, const U& b) {
+   return std::move(a /= b);
+}
+
+template <class T, class Alloc, class U>
+dynamic_poly<T, Alloc> operator % (dynamic_poly<T, Alloc> a, const U& b) {
+   return std::move(a %= b);
+}
+
+template <class U, class T, class Alloc>
+dynamic_poly<T, Alloc> operator + (const U& a, dynamic_poly<T, Alloc> b) {
+   return std::move(b += a);
+}
+
+template <class U, class T, class Alloc>
+dynamic_poly<T, Alloc> operator - (const U& a, dynamic_poly<T, Alloc> b) {
+   return std::move(-std::move(b) += a);
+}
+
+template <class U, class T, class Alloc>
+dynamic_poly<T, Alloc> operator * (const U& a, dynamic_poly<T, Alloc> b) {
+   return std::move(b *= a);
+}
+
+// Unary minus (negate).
+template <class T, class Alloc>
+dynamic_poly<T, Alloc> operator - (dynamic_poly<T, Alloc> a) {
+   for (int i = 0; i < a.m_size; ++i)
+      a.m_data[i] *= -1;
+   return a;
+}
+
+template <class T, class Alloc>
+dynamic_poly<T, Alloc> operator + (dynamic_poly<T, Alloc> a, const dynamic_poly<T, Alloc>& b) {
+   return std::move(a += b);
+}
+
+template <class T, class Alloc>
+dynamic_poly<T, Alloc> operator - (dynamic_poly<T, Alloc> a, const dynamic_poly<T, Alloc>& b) {
+   return std::move(a -= b);
+}
+
+template <class T, class Alloc>
+dynamic_poly<T, Alloc> operator * (const dynamic_poly<T, Alloc>& a, const dynamic_poly<T, Alloc>& b) {
+   dynamic_poly<T, Alloc> prod(a.get_allocator());
+   multiply(a, b, prod);
+   return prod;
+}
+
+template <class T, class Alloc>
+dynamic_poly<T, Alloc> operator / (const dynamic_poly<T, Alloc>& a, const dynamic_poly<T, Alloc>& b) {
+   return std::move(quotient_remainder(a, b).first);
+}
+
+template <class T, class Alloc>
+dynamic_poly<T, Alloc> operator % (const dynamic_poly<T, Alloc>& a, const dynamic_poly<T, Alloc>& b) {
+   return std::move(quotient_remainder(a, b).second);
+}
+
+template <class T, class Alloc>
+bool operator == (const dynamic_poly<T, Alloc> &a, const dynamic_poly<T, Alloc> &b) {
+   int n = a.degree();
+   if (b.degree() != n) return false;
+   for (; n >= 0; --n)
+      if (a[n] != b[n]) return false;
+   return true;
+}
+
+template <class T, class Alloc>
+bool operator != (const dynamic_poly<T, Alloc> &a, const dynamic_poly<T, Alloc> &b) {
+   return !(a == b);
+}
+
+template <class T, class Alloc>
+bool operator < (const dynamic_poly<T, Alloc> &a, const dynamic_poly<T, Alloc> &b) {
+   int k = a.degree();
+   if (b.degree() != k)
+        return k < b.degree();
+   for (; k >= 0; --k) {
+      if (a[k] != b[k])
+         return a[k] < b[k];
+   }
+   return false; // equal
+}
+
+template <class T, class Alloc>
+bool operator <= (const dynamic_poly<T, Alloc> &a, const dynamic_poly<T, Alloc> &b) {
+   return a < b || a == b;
+}
+
+template <class T, class Alloc>
+bool operator >= (const dynamic_poly<T, Alloc> &a, const dynamic_poly<T, Alloc> &b) {
+   return !(a < b);
+}
+
+template <class T, class Alloc>
+bool operator > (const dynamic_poly<T, Alloc> &a, const dynamic_poly<T, Alloc> &b) {
+   return !(a <= b);
+}
+
+/* The pow with an argument for exp that static_poly can't have: the size of
+ * the result is only known at run time.  Squares and products alternate
+ * between two buffers. */
+template <class T, class Alloc>
+dynamic_poly<T, Alloc> power(const dynamic_poly<T, Alloc>& b, int exp) {
+   assert(exp >= 0 && "Negative power not supported");
+   dynamic_poly<T, Alloc> result(T{1}, b.get_allocator()), base(b), tmp(b.get_allocator());
+   if (exp & 1)
+      result = base;
+   /* "Exponentiation by squaring" */
+   while (exp >>= 1) {
+      square(base, tmp);
+      swap(base, tmp);
+      if (exp & 1) {
+         multiply(result, base, tmp);
+         swap(result, tmp);
+      }
+   }
+   return result;
+}
+
+#endif // NAM_DYNAMIC_POLY_HPP
@@ -7,34 +7,22 @@
 #ifndef NAM_EVALUATE_HPP
 #define NAM_EVALUATE_HPP
 
-#include <boost/mpl/int.hpp>
-namespace mpl = boost::mpl;
-#include "polynomial_horner2_20.hpp"
-
-//
-// Forward declaration to keep two phase lookup happy:
-//
-template <class T, class U>
-constexpr U evaluate_polynomial(const T* poly, U const& z, std::size_t count);
-
-namespace detail {
-    // Fallback if none of the unrolled ones (up to size 20) suffice
-    template <class T, class V, class Tag>
-    constexpr V evaluate_polynomial_c_imp(const T* a, const V& val, const Tag*) {
-       return evaluate_polynomial(a, val, Tag::value);
-    }
-} // namespace detail
+#include <cstddef> // size_t
+#include <type_traits> // conditional_t
+#include "polynomial_schemes.hpp"
 
 //
 // Polynomial evaluation with runtime size.
 // This requires a for-loop which may be more expensive than
-// the loop expanded versions above:
+// the loop expanded versions below:
 //
 template <class T, class U>
 constexpr U evaluate_polynomial(const T* poly, U const& z, std::size_t count) {
-   assert(count > 0);
+   if (count == 0)
+      return static_cast<U>(0);
    U sum = static_cast<U>(poly[count - 1]);
-   for(int i = static_cast<int>(count) - 2; i >= 0; --i) {
+   for (std::size_t i = count - 1; i > 0;) {
+      --i;
       sum *= z;
       sum += static_cast<U>(poly[i]);
    }
@@ -42,13 +30,22 @@ constexpr U evaluate_polynomial(const T* poly, U const& z, std::size_t count) {
 }
 
 //
-// Compile time sized polynomials, just inline forwarders to the
-// implementations above:
+// Compile time sized polynomials, unrolled for any size: Horner's rule
+// up to four terms, and the second order Horner rule beyond that.
 //
 template <std::size_t N, class T, class V>
 constexpr V evaluate_polynomial(const T(&a)[N], const V& val) {
-   typedef mpl::int_<N> tag_type;
-   return detail::evaluate_polynomial_c_imp(static_cast<const T*>(a), val, static_cast<tag_type const*>(0));
+   typedef std::conditional_t<(N < 5), horner_scheme<1>, horner_scheme<2> > scheme;
+   return detail::evaluate_scheme<scheme, N>(static_cast<const T*>(a), val);
+}
+
+//
+// Compile time sized polynomials with a chosen evaluation scheme
+// (horner_scheme<K>, estrin_scheme or auto_scheme):
+//
+template <class Scheme, std::size_t N, class T, class V>
+constexpr V evaluate_polynomial(const T(&a)[N], const V& val) {
+   return detail::evaluate_scheme<Scheme, N>(static_cast<const T*>(a), val);
 }
 
 #endif // NAM_EVALUATE_HPP
@@ -0,0 +1,199 @@
+/*  Batched evaluation of a compile-time sized polynomial at many points.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_EVALUATE_MANY_HPP
+#define NAM_EVALUATE_MANY_HPP
+
+#include <cstddef> // size_t
+#include <type_traits> // is_arithmetic, integral_constant
+#include "static_poly.hpp"
+
+/* Width in bytes of the vector registers on the target. Define this before
+ * including to override the guess from the target macros; 1 gives the scalar
+ * fallback. */
+#ifndef NAM_STATIC_POLY_SIMD_BYTES
+#  if defined(__AVX512F__)
+#    define NAM_STATIC_POLY_SIMD_BYTES 64
+#  elif defined(__AVX__)
+#    define NAM_STATIC_POLY_SIMD_BYTES 32
+#  elif defined(__SSE2__) || defined(__ARM_NEON) || defined(__ALTIVEC__)
+#    define NAM_STATIC_POLY_SIMD_BYTES 16
+#  else
+#    define NAM_STATIC_POLY_SIMD_BYTES 1
+#  endif
+#endif
+
+namespace detail {
+
+/* W values of type V, with elementwise arithmetic.
+ * Feeding this to the scalar kernels of evaluate.hpp evaluates W points at
+ * once: every lane goes through exactly the operations of the scalar path,
+ * in the same order, so the results agree bit for bit (as long as the
+ * compiler doesn't contract differently into FMAs).
+ * With GCC and clang the lanes are a vector extension type, so each operation
+ * is one or a few SIMD instructions; elsewhere they're a plain array and we
+ * count on the auto-vectorizer. */
+template <class V, int W>
+struct lanes {
+#if defined(__GNUC__)
+   typedef V storage __attribute__((vector_size(W * sizeof(V))));
+#else
+   typedef V storage[W];
+#endif
+   storage v;
+
+   constexpr lanes() : v{} {}
+
+   // broadcast; implicit, so that coefficients mix with lanes in the kernels
+#if defined(__GNUC__)
+   constexpr lanes(const V& s) : v{s - storage{}} {} // keeps the sign of -0.0
+#else
+   constexpr lanes(const V& s) : v{} {
+      for (int l = 0; l < W; ++l)
+         v[l] = s;
+   }
+#endif
+
+   constexpr V operator[] (int l) const {
+      return v[l];
+   }
+
+   constexpr void set(int l, const V& s) {
+      v[l] = s;
+   }
+
+#if defined(__GNUC__)
+   constexpr lanes& operator +=(const lanes& o) {
+      v += o.v;
+      return *this;
+   }
+
+   constexpr lanes& operator -=(const lanes& o) {
+      v -= o.v;
+      return *this;
+   }
+
+   constexpr lanes& operator *=(const lanes& o) {
+      v *= o.v;
+      return *this;
+   }
+#else
+   constexpr lanes& operator +=(const lanes& o) {
+      for (int l = 0; l < W; ++l)
+         v[l] += o.v[l];
+      return *this;
+   }
+
+   constexpr lanes& operator -=(const lanes& o) {
+      for (int l = 0; l < W; ++l)
+         v[l] -= o.v[l];
+      return *this;
+   }
+
+   constexpr lanes& operator *=(const lanes& o) {
+      for (int l = 0; l < W; ++l)
+         v[l] *= o.v[l];
+      return *this;
+   }
+#endif
+
+   friend constexpr lanes operator + (const lanes& a, const lanes& b) {
+      lanes r = a;
+      return r += b;
+   }
+
+   friend constexpr lanes operator - (const lanes& a, const lanes& b) {
+      lanes r = a;
+      return r -= b;
+   }
+
+   friend constexpr lanes operator * (const lanes& a, const lanes& b) {
+      lanes r = a;
+      return r *= b;
+   }
+};
+
+/* How many points of type V to evaluate per block: one vector register.
+ * (Wider blocks get split by the compiler and end up slower than the scalar
+ * loop.)  Types the vector units don't handle go one at a time. */
+template <class V>
+constexpr int simd_lanes() {
+   return std::is_arithmetic<V>::value && sizeof(V) < NAM_STATIC_POLY_SIMD_BYTES
+        ? NAM_STATIC_POLY_SIMD_BYTES / int(sizeof(V))
+        : 1;
+}
+
+} // namespace detail
+
+namespace detail {
+   // stands for plain evaluate_polynomial(a, x), in place of a Scheme
+   struct default_evaluation {};
+
+   template <std::size_t N, class T, class V>
+   constexpr V evaluate_with(const T(&a)[N], const V& x, const default_evaluation*) {
+      return evaluate_polynomial(a, x);
+   }
+
+   template <std::size_t N, class T, class V, class Scheme>
+   constexpr V evaluate_with(const T(&a)[N], const V& x, const Scheme*) {
+      return evaluate_polynomial<Scheme>(a, x);
+   }
+
+   template <class Scheme, std::size_t N, class T, class V, int W>
+   void evaluate_polynomial_many_imp(const T(&a)[N], const V* xs, V* out, std::size_t n,
+                                     const std::integral_constant<int, W>*) {
+      const Scheme* scheme = nullptr;
+      const std::size_t blocked = n - n % W;
+      std::size_t i = 0;
+      for (; i < blocked; i += W) {
+         lanes<V, W> x;
+         for (int l = 0; l < W; ++l)
+            x.set(l, xs[i + l]);
+         const lanes<V, W> y = evaluate_with(a, x, scheme);
+         for (int l = 0; l < W; ++l)
+            out[i + l] = y[l];
+      }
+      for (; i < n; ++i) // scalar tail
+         out[i] = evaluate_with(a, xs[i], scheme);
+   }
+
+   // scalar fallback
+   template <class Scheme, std::size_t N, class T, class V>
+   void evaluate_polynomial_many_imp(const T(&a)[N], const V* xs, V* out, std::size_t n,
+                                     const std::integral_constant<int, 1>*) {
+      const Scheme* scheme = nullptr;
+      for (std::size_t i = 0; i < n; ++i)
+         out[i] = evaluate_with(a, xs[i], scheme);
+   }
+} // namespace detail
+
+/* Evaluate the polynomial with coefficients a at xs[0], ..., xs[n-1],
+ * storing the values in out[0], ..., out[n-1].
+ * The results are those of evaluate_polynomial(a, xs[i]), or of
+ * evaluate_polynomial<Scheme>(a, xs[i]) if a Scheme is given. */
+template <std::size_t N, class T, class V>
+void evaluate_polynomial_many(const T(&a)[N], const V* xs, V* out, std::size_t n) {
+   typedef std::integral_constant<int, detail::simd_lanes<V>()> tag_type;
+   detail::evaluate_polynomial_many_imp<detail::default_evaluation>(
+      a, xs, out, n, static_cast<tag_type const*>(0));
+}
+
+template <class Scheme, std::size_t N, class T, class V>
+void evaluate_polynomial_many(const T(&a)[N], const V* xs, V* out, std::size_t n) {
+   typedef std::integral_constant<int, detail::simd_lanes<V>()> tag_type;
+   detail::evaluate_polynomial_many_imp<Scheme>(a, xs, out, n, static_cast<tag_type const*>(0));
+}
+
+template <class T, int N>
+void evaluate_many(const static_poly<T, N>& poly, const T* xs, T* out, std::size_t n) {
+   evaluate_polynomial_many(poly.m_data, xs, out, n);
+}
+
+template <class Scheme, class T, int N>
+void evaluate_many(const static_poly<T, N>& poly, const T* xs, T* out, std::size_t n) {
+   evaluate_polynomial_many<Scheme>(poly.m_data, xs, out, n);
+}
+
+#endif // NAM_EVALUATE_MANY_HPP
@@ -1,5 +1,10 @@
 #include <iostream>
 #include "static_poly_io.hpp"
+#include "interpolate.hpp"
+#include "roots.hpp"
+#include "gcd.hpp"
+#include "compose.hpp"
+#include "poly_bank.hpp"
 
 using std::cout;
 
@@ -11,6 +16,47 @@ constexpr int qux(static_poly<int, 4> bar) {
     return bar.degree();
 }
 
+constexpr static_poly<int, 24> flat(int c) { // c + c x + ... + c x^23
+    static_poly<int, 24> p;
+    for (int i = 0; i < 24; ++i)
+        p[i] = c;
+    return p;
+}
+
+template <int N>
+constexpr static_poly<unsigned long long, N> sevens() { // 0, 1, ..., 6, 0, 1, ...
+    static_poly<unsigned long long, N> p;
+    for (int i = 0; i < N; ++i)
+        p[i] = i % 7;
+    return p;
+}
+
+template <int N>
+constexpr static_poly<unsigned long long, N> shift_by_horner(static_poly<unsigned long long, N> p, unsigned long long a) {
+    detail::taylor_shift_horner(p.m_data, N, a);
+    return p;
+}
+
+constexpr poly_bank<int, 3, 10> squares() { // (x + j)^2 for j < 10
+    poly_bank<int, 3, 10> bank;
+    for (int j = 0; j < bank.size(); ++j)
+        bank.set(j, static_poly<int, 3>{j * j, 2 * j, 1});
+    return bank;
+}
+
+struct line_points {
+    long long x[64], y[64];
+};
+
+constexpr line_points on_line() { // (i, 2i + 1) for i < 64
+    line_points p{};
+    for (int i = 0; i < 64; ++i) {
+        p.x[i] = i;
+        p.y[i] = 2*i + 1;
+    }
+    return p;
+}
+
 
 int main() {
     constexpr static_poly<int, 3> x2p1{1,0,1}; // x^2 + 1
@@ -36,6 +82,11 @@ int main() {
     cout << bigprod << "\n"
          "Cubed:  " << power<3>(bigprod) << "\n\n";
 
+    // Karatsuba's sums of halves pass INT_MAX here, the coefficients don't
+    constexpr auto flatprod = flat(9000) * flat(9000);
+    static_assert(flatprod[23] == 24 * 81000000 && flatprod[0] == 81000000, "int product from 24 terms");
+    static_assert(power<2>(flat(9000)) == flatprod, "int square from 24 terms");
+
     /* Cyclotomic polynomials */
     constexpr auto phi1 = x - 1;
     constexpr auto phi2 = x + 1;
@@ -64,6 +115,57 @@ int main() {
 
     constexpr bool eq = ( (x*x - 1) == (x + 1)*(x - 1) );
     cout << "x^2 - 1 = (x + 1)(x - 1)? " << eq << '\n';
+
+    constexpr auto rem = (x*x - 1) % (x - 1);
+    static_assert(rem == static_poly<int, 1>{0}, "x - 1 divides x^2 - 1");
+    static_assert((x*x - 1) / (x - 1) == x + 1, "(x^2 - 1)/(x - 1) = x + 1");
+    cout << "(x^2 - 1) mod (x - 1): " << rem << '\n';
+
+    // (x^4)^2 modulo x^2 + 1; the modulus is declared with room for degree 4
+    constexpr auto x8 = power_mod<2>(static_poly<int, 5>{0,0,0,0,1}, static_poly<int, 5>{1,0,1});
+    static_assert(x8 == static_poly<int, 4>{1}, "x^8 = 1 modulo x^2 + 1");
+    cout << "x^8 mod x^2 + 1: " << x8 << '\n';
+
+    // the line through 64 points of y = 2x + 1, over the integers
+    constexpr line_points line = on_line();
+    constexpr auto fit = interpolate<64>(line.x, line.y);
+    static_assert(fit == static_poly<long long, 2>{1, 2}, "interpolate<64> over long long");
+    cout << "Through 64 points of 2x + 1: " << fit << '\n';
+
+    // real roots by Sturm sequences and Newton's method, at compile time
+    constexpr static_poly<double, 4> cubic{6, -5, -2, 1}; // (x + 2)(x - 1)(x - 3)
+    constexpr auto roots = real_roots(cubic);
+    static_assert(roots.size() == 3 && roots[0] == -2 && roots[1] == 1 && roots[2] == 3, "roots -2, 1, 3");
+    cout << "Roots of " << cubic << ": " << roots[0] << ", " << roots[1] << ", " << roots[2] << '\n';
+
+    // x^3 - 1 and x^2 - 1 share the factor x - 1, so their resultant is 0
+    constexpr static_poly<long long, 4> x3m1{-1, 0, 0, 1};
+    constexpr static_poly<long long, 3> x2m1{-1, 0, 1};
+    static_assert(gcd(x3m1, x2m1) == static_poly<long long, 2>{-1, 1}, "gcd is x - 1");
+    static_assert(resultant(x3m1, x2m1) == 0, "common factor, resultant 0");
+    // (1 + x)(1 - x^2) = -(x - 1)(x + 1)^2
+    constexpr auto sqf = squarefree_factorization(static_poly<long long, 4>{1, 1, -1, -1});
+    static_assert(sqf.m_count == 2 && sqf.m_unit == -1 && sqf.m_factors[0] == static_poly<long long, 2>{-1, 1}
+                  && sqf.m_factors[1] == static_poly<long long, 2>{1, 1}, "-(x - 1)(x + 1)^2");
+    cout << "gcd(" << x3m1 << ", " << x2m1 << ") = " << gcd(x3m1, x2m1) << '\n';
+
+    // 1 + 2q + 3q^2 for q = x + x^2
+    constexpr auto comp = compose(static_poly<int, 3>{1, 2, 3}, static_poly<int, 3>{0, 1, 1});
+    static_assert(comp == static_poly<int, 5>{1, 2, 5, 6, 3}, "3x^4 + 6x^3 + 5x^2 + 2x + 1");
+    cout << "Composed: " << comp << '\n';
+    // from 256 terms taylor_shift divides and conquers; modulo 2^64 it must
+    // agree with synthetic division exactly
+    static_assert(taylor_shift(sevens<300>(), 3ull) == shift_by_horner(sevens<300>(), 3ull),
+                  "taylor_shift above the threshold");
+
+    constexpr auto bank = squares();
+    static_assert(bank.get(7) == static_poly<int, 3>{49, 14, 1}, "(x + 7)^2");
+    int at2[10];
+    bank.evaluate_all(2, at2);
+    for (int j = 0; j < bank.size(); ++j)
+        if (at2[j] != bank.get(j)(2))
+            cout << "poly_bank disagrees at " << j << '\n';
+    cout << "(2 + 9)^2 = " << at2[9] << '\n';
     
     return 0;
 }
@@ -0,0 +1,422 @@
+/*  Greatest common divisors, squarefree factorization and resultants of
+ *  polynomials, by subresultant pseudo-remainder sequences.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_GCD_HPP
+#define NAM_GCD_HPP
+
+#include <algorithm> // max
+#include <limits> // numeric_limits
+#include <type_traits> // is_integral, integral_constant
+#include "static_poly.hpp"
+#include "derivatives.hpp" // derivative
+
+namespace detail {
+   // the gcd of two integers, nonnegative
+   template <class T>
+   constexpr T integer_gcd(T a, T b) {
+      while (b != T(0)) {
+         const T r = a % b;
+         a = b;
+         b = r;
+      }
+      return a < T(0) ? -a : a;
+   }
+
+   /* The gcd of the coefficients of p over an integral type, signed as its
+    * leading coefficient; over a field, the leading coefficient, so that
+    * dividing by the content leaves a primitive or a monic polynomial. */
+   template <class T, int N>
+   constexpr T content(const static_poly<T, N>& p, std::true_type /* integral */) {
+      T c = T(0);
+      for (int i = 0; i < N; ++i)
+         c = integer_gcd(c, p[i]);
+      const int n = p.degree();
+      return n >= 0 && p[n] < T(0) ? -c : c;
+   }
+
+   template <class T, int N>
+   constexpr T content(const static_poly<T, N>& p, std::false_type) {
+      const int n = p.degree();
+      return n >= 0 ? p[n] : T(0);
+   }
+
+   template <class T, int N>
+   constexpr T content(const static_poly<T, N>& p) {
+      return content(p, std::is_integral<T>());
+   }
+
+   // p over its content: primitive with a positive leading coefficient, or monic
+   template <class T, int N>
+   constexpr static_poly<T, N> primitive_part(const static_poly<T, N>& p) {
+      const T c = content(p);
+      return c == T(0) ? p : p / c;
+   }
+
+   // the gcd of the contents of a and b, which goes into the gcd; 1 over a field
+   template <class T, int N>
+   constexpr T common_content(const static_poly<T, N>& a, const static_poly<T, N>& b, std::true_type /* integral */) {
+      return integer_gcd(content(a), content(b));
+   }
+
+   template <class T, int N>
+   constexpr T common_content(const static_poly<T, N>&, const static_poly<T, N>&, std::false_type) {
+      return T(1);
+   }
+
+   /* prem(u, v) = lc(v)^(m-n+1) u mod v, for u of degree m >= n, the degree of
+    * v.  long_division pseudo-divides over integral types, and gives the true
+    * remainder over fields and for integral divisors with a leading
+    * coefficient of ±1, which is then scaled to match. */
+   template <class T, int N>
+   constexpr static_poly<T, N> pseudo_remainder(static_poly<T, N> u, const static_poly<T, N>& v, int m, int n) {
+      T q[N] {};
+      long_division(q, u.m_data, v.m_data, m, n);
+      if (!std::is_integral<T>::value || use_monic_division(v[n], std::is_integral<T>()))
+         u *= integer_power(v[n], m - n + 1);
+      return u;
+   }
+
+   // u / v, for v dividing u exactly: over an integral type, as a primitive v does u in Z[x]
+   template <class T, int N>
+   constexpr static_poly<T, N> exact_quotient(static_poly<T, N> u, const static_poly<T, N>& v) {
+      const int m = u.degree(), n = v.degree();
+      static_poly<T, N> q;
+      for (int k = m - n; k >= 0; --k) {
+         q[k] = u[n + k] / v[n];
+         for (int j = 0; j <= n; ++j)
+            u[j + k] -= q[k] * v[j];
+      }
+      return q;
+   }
+
+   /* The subresultant PRS (Collins; Brown; Cohen, A Course in Computational
+    * Algebraic Number Theory, 3.3.1), for a and b primitive (or monic) with
+    * b nonzero and of degree at most that of a: the pseudo-remainders are
+    * divided by g h^δ, which they are exactly divisible by, so their
+    * coefficients grow only as the subresultants, which are determinants of
+    * the coefficients, rather than exponentially as with plain pseudo-division.
+    * Returns the gcd, primitive (or monic). */
+   template <class T, int N>
+   constexpr static_poly<T, N> subresultant_gcd(static_poly<T, N> a, static_poly<T, N> b) {
+      T g = T(1), h = T(1);
+      for (;;) {
+         const int m = a.degree(), n = b.degree(), delta = m - n;
+         const static_poly<T, N> r = pseudo_remainder(a, b, m, n);
+         if (!r)
+            break;
+         if (r.degree() == 0)
+            return static_poly<T, N>{T(1)};
+         a = b;
+         b = r / (g * integer_power(h, delta));
+         g = a[a.degree()];
+         h = delta ? integer_power(g, delta) / integer_power(h, delta - 1) : h;
+      }
+      return primitive_part(b);
+   }
+
+   // primes below 2^31, so that products of residues fit in 64 bits
+   constexpr unsigned long long gcd_primes[] = {
+      2147483647, 2147483629, 2147483587, 2147483579, 2147483563, 2147483549, 2147483543, 2147483497,
+      2147483489, 2147483477, 2147483423, 2147483399, 2147483353, 2147483323, 2147483269, 2147483249};
+   constexpr int gcd_prime_count = sizeof(gcd_primes) / sizeof(gcd_primes[0]);
+
+   // x mod p, in [0, p), for signed integral x
+   template <class T>
+   constexpr unsigned long long residue(const T& x, unsigned long long p) {
+      const long long r = static_cast<long long>(x) % static_cast<long long>(p);
+      return r < 0 ? static_cast<unsigned long long>(r + static_cast<long long>(p)) : r;
+   }
+
+   // a^(p-2) = 1 / a mod p
+   constexpr unsigned long long inverse_mod(unsigned long long a, unsigned long long p) {
+      unsigned long long result = 1;
+      for (unsigned long long e = p - 2; e; e >>= 1) {
+         if (e & 1)
+            result = result * a % p;
+         a = a * a % p;
+      }
+      return result;
+   }
+
+   /* The monic gcd of a and b, of degrees m >= 0 and n, modulo p, by Euclid's
+    * algorithm: left in a, and its degree returned. */
+   template <int N>
+   constexpr int gcd_mod(unsigned long long (&a)[N], unsigned long long (&b)[N], int m, int n, unsigned long long p) {
+      while (n >= 0) {
+         const unsigned long long inv = inverse_mod(b[n], p);
+         for (int k = m - n; k >= 0; --k) {
+            const unsigned long long q = a[n + k] * inv % p;
+            for (int j = 0; j <= n; ++j)
+               a[j + k] = (a[j + k] + (p - q) * b[j]) % p;
+         }
+         for (m = n - 1; m >= 0 && a[m] == 0; --m) {}
+         for (int i = 0; i < N; ++i) {
+            const unsigned long long t = a[i];
+            a[i] = b[i];
+            b[i] = t;
+         }
+         const int t = m;
+         m = n;
+         n = t;
+      }
+      const unsigned long long inv = inverse_mod(a[m], p);
+      for (int i = 0; i <= m; ++i)
+         a[i] = a[i] * inv % p;
+      return m;
+   }
+
+   // whether a * b, and a - b, fit in a signed integral T
+   template <class T>
+   constexpr bool product_fits(const T& a, const T& b) {
+      constexpr T max = std::numeric_limits<T>::max(), min = std::numeric_limits<T>::min();
+      return a == T(0) || b == T(0)
+          || (a > T(0) ? (b > T(0) ? a <= max / b : b >= min / a)
+                       : (b > T(0) ? a >= min / b : a >= max / b));
+   }
+
+   template <class T>
+   constexpr bool difference_fits(const T& a, const T& b) {
+      return b > T(0) ? a >= std::numeric_limits<T>::min() + b : a <= std::numeric_limits<T>::max() + b;
+   }
+
+   // whether h divides u over the integers, by long division that gives up on overflow
+   template <class T, int N>
+   constexpr bool divides(const static_poly<T, N>& h, static_poly<T, N> u) {
+      const int n = h.degree();
+      for (int k = u.degree() - n; k >= 0; --k) {
+         if (u[n + k] % h[n] != T(0))
+            return false;
+         const T q = u[n + k] / h[n];
+         for (int j = 0; j <= n; ++j) {
+            if (!product_fits(q, h[j]) || !difference_fits(u[j + k], q * h[j]))
+               return false;
+            u[j + k] -= q * h[j];
+         }
+      }
+      return !u;
+   }
+
+   /* Brown's modular gcd, for a and b primitive of degrees at least 1 over a
+    * signed integral type: the monic gcd modulo primes p, times the gcd l of
+    * the leading coefficients, is combined by the Chinese remainder theorem
+    * (in mixed radix, so nothing wider than T is needed) until another prime
+    * leaves it unchanged; the primitive part of that is the gcd if it divides
+    * a and b.  Primes giving a gcd of higher degree than another are unlucky,
+    * and left out.  Everything stays within the size of the inputs and of the
+    * gcd, where the PRS goes through the size of the subresultants.  Sets ok
+    * to false if the primes run out first. */
+   template <class T, int N>
+   constexpr static_poly<T, N> modular_gcd(const static_poly<T, N>& a, const static_poly<T, N>& b, bool& ok) {
+      const int m = a.degree(), n = b.degree();
+      const T l = integer_gcd(a[m], b[n]);
+      long long digits[N][gcd_prime_count] {};
+      unsigned long long used[gcd_prime_count] {};
+      int count = 0, degree = N;
+      ok = true;
+      for (int k = 0; k < gcd_prime_count; ++k) {
+         const unsigned long long p = gcd_primes[k];
+         if (residue(a[m], p) == 0 || residue(b[n], p) == 0)
+            continue;
+         unsigned long long ap[N] {}, bp[N] {};
+         for (int i = 0; i < N; ++i) {
+            ap[i] = residue(a[i], p);
+            bp[i] = residue(b[i], p);
+         }
+         const int d = gcd_mod(ap, bp, m, n, p);
+         if (d == 0)
+            return static_poly<T, N>{T(1)};
+         if (d > degree)
+            continue;
+         if (d < degree) {
+            degree = d;
+            count = 0;
+         }
+         // the next mixed radix digit of each coefficient of l times the gcd
+         unsigned long long radix = 1;
+         for (int j = 0; j < count; ++j)
+            radix = radix * (used[j] % p) % p;
+         const unsigned long long inv = inverse_mod(radix, p), lp = residue(l, p);
+         bool stable = count > 0;
+         for (int i = 0; i <= degree; ++i) {
+            unsigned long long v = 0;
+            for (int j = count; j > 0; --j)
+               v = (v * (used[j - 1] % p) + residue(digits[i][j - 1], p)) % p;
+            const unsigned long long t = (ap[i] * lp % p + p - v) % p * inv % p;
+            digits[i][count] = t > p / 2 ? static_cast<long long>(t) - static_cast<long long>(p)
+                                         : static_cast<long long>(t);
+            stable = stable && t == 0;
+         }
+         used[count++] = p;
+         if (!stable)
+            continue;
+         static_poly<T, N> h;
+         bool fits = true;
+         for (int i = 0; i <= degree && fits; ++i) {
+            for (int j = count; j > 0 && fits; --j) {
+               const unsigned long long pj = used[j - 1];
+               fits = (j == count || (pj <= static_cast<unsigned long long>(std::numeric_limits<T>::max())
+                                      && product_fits(h[i], T(pj))));
+               if (fits && j < count)
+                  h[i] *= T(pj);
+               const T dj = T(digits[i][j - 1]);
+               fits = fits && difference_fits(h[i], T(-dj));
+               if (fits)
+                  h[i] += dj;
+            }
+         }
+         if (!fits)
+            continue;
+         h = primitive_part(h);
+         if (divides(h, a) && divides(h, b))
+            return h;
+      }
+      ok = false;
+      return static_poly<T, N>();
+   }
+
+   // the gcd of primitive a and b, nonzero, of degrees m >= n
+   template <class T, int N>
+   constexpr static_poly<T, N> primitive_gcd(const static_poly<T, N>& a, const static_poly<T, N>& b, std::true_type /* integral */) {
+      static_assert(std::is_signed<T>::value, "gcd over the integers needs a signed type");
+      if (b.degree() == 0)
+         return static_poly<T, N>{T(1)};
+      bool ok = false;
+      const static_poly<T, N> g = modular_gcd(a, b, ok);
+      return ok ? g : subresultant_gcd(a, b);
+   }
+
+   template <class T, int N>
+   constexpr static_poly<T, N> primitive_gcd(const static_poly<T, N>& a, const static_poly<T, N>& b, std::false_type) {
+      return subresultant_gcd(a, b);
+   }
+}
+
+/* The greatest common divisor of a and b.  Over an integral (signed) type it
+ * is exact and in lowest terms: the primitive gcd times the gcd of the
+ * contents, with a positive leading coefficient.  It is found by Brown's
+ * modular algorithm, in which nothing outgrows the inputs and the gcd itself,
+ * falling back on the subresultant PRS in the unlikely case that the primes
+ * run out; the PRS's intermediate coefficients are the size of determinants
+ * of the inputs', and overflow long long from degree 7 or so.  Over a field
+ * it is monic, by the subresultant PRS.  T must be exact (by
+ * std::numeric_limits): in floating point the remainders don't come out zero,
+ * and the gcd of p and p' is 1.  sturm_sequence (roots.hpp) is the tolerant
+ * alternative for roots. */
+template <class T, int N1, int N2>
+constexpr static_poly<T, std::max(N1, N2)> gcd(const static_poly<T, N1>& a0, const static_poly<T, N2>& b0) {
+   static_assert(std::numeric_limits<T>::is_exact, "gcd needs exact coefficients; see sturm_sequence for floating point");
+   constexpr int N = std::max(N1, N2);
+   static_poly<T, N> a(a0), b(b0);
+   if (a.degree() < b.degree()) {
+      const static_poly<T, N> t = a;
+      a = b;
+      b = t;
+   }
+   const T d = detail::common_content(a, b, std::is_integral<T>());
+   if (!b)
+      return detail::primitive_part(a) * d;
+   return detail::primitive_gcd(detail::primitive_part(a), detail::primitive_part(b), std::is_integral<T>()) * d;
+}
+
+/* p with each root once: p / gcd(p, p'), primitive or monic as gcd.  Over an
+ * integral type, the content of p goes.  Exact types only, as gcd; in floating
+ * point, sturm_sequence::squarefree (roots.hpp) tolerates rounding. */
+template <class T, int N>
+constexpr static_poly<T, N> squarefree_part(const static_poly<T, N>& p) {
+   static_assert(std::numeric_limits<T>::is_exact, "squarefree_part needs exact coefficients; see sturm_sequence for floating point");
+   if (p.degree() < 1)
+      return detail::primitive_part(p);
+   const static_poly<T, N> q = detail::primitive_part(p);
+   return detail::primitive_part(detail::exact_quotient(q, gcd(q, static_poly<T, N>(derivative(q)))));
+}
+
+/* p = m_unit m_factors[0] m_factors[1]^2 ... m_factors[m_count-1]^m_count,
+ * with the factors squarefree and pairwise coprime: m_factors[i] has the roots
+ * of multiplicity i + 1.  Each is primitive, or monic, as gcd; a multiplicity
+ * without roots has the factor 1. */
+template <class T, int N>
+struct squarefree_factors {
+   static_poly<T, N> m_factors[N];
+   int m_count;
+   T m_unit;
+};
+
+/* Yun's algorithm: with b = p / gcd(p, p') and d = p' / gcd(p, p') - b', each
+ * gcd(b, d) is the next factor, divided out of b and of d on the way.  Exact
+ * types only, as gcd. */
+template <class T, int N>
+constexpr squarefree_factors<T, N> squarefree_factorization(const static_poly<T, N>& p) {
+   static_assert(std::numeric_limits<T>::is_exact, "squarefree_factorization needs exact coefficients");
+   squarefree_factors<T, N> out {{}, 0, T(0)};
+   const int n = p.degree();
+   if (n < 1) {
+      out.m_unit = n < 0 ? T(0) : p[0];
+      return out;
+   }
+   const static_poly<T, N> q = detail::primitive_part(p);
+   const static_poly<T, N> dq(derivative(q));
+   const static_poly<T, N> a0 = gcd(q, dq);
+   static_poly<T, N> b = detail::exact_quotient(q, a0);
+   static_poly<T, N> d = detail::exact_quotient(dq, a0) - static_poly<T, N>(derivative(b));
+   T lc = T(1);
+   while (b.degree() > 0) {
+      const static_poly<T, N> a = gcd(b, d);
+      out.m_factors[out.m_count++] = a;
+      lc *= detail::integer_power(a[a.degree()], out.m_count);
+      b = detail::exact_quotient(b, a);
+      d = detail::exact_quotient(d, a) - static_poly<T, N>(derivative(b));
+   }
+   out.m_unit = p[n] / lc;
+   return out;
+}
+
+/* The resultant of a and b: the product of a's leading coefficient to the
+ * degree of b, b's to the degree of a, and the differences of their roots;
+ * zero just when they have a common factor.  By the subresultant PRS (Cohen,
+ * 3.3.7), exact over integral types, with the same growth as gcd.  A constant
+ * has resultant c^n with a polynomial of degree n; 0 with 0.  Exact types
+ * only, as gcd: in floating point a common factor leaves a remainder of
+ * rounding errors rather than zero. */
+template <class T, int N1, int N2>
+constexpr T resultant(const static_poly<T, N1>& a0, const static_poly<T, N2>& b0) {
+   static_assert(std::numeric_limits<T>::is_exact, "resultant needs exact coefficients");
+   constexpr int N = std::max(N1, N2);
+   static_poly<T, N> a(a0), b(b0);
+   if (!a || !b)
+      return T(0);
+   T s = T(1);
+   if (a.degree() < b.degree()) {
+      const static_poly<T, N> t = a;
+      a = b;
+      b = t;
+      if (a.degree() % 2 && b.degree() % 2)
+         s = -s;
+   }
+   if (b.degree() == 0)
+      return s * detail::integer_power(b[0], a.degree());
+   const T ca = detail::content(a, std::is_integral<T>()), cb = detail::content(b, std::is_integral<T>());
+   const T t = detail::integer_power(ca, b.degree()) * detail::integer_power(cb, a.degree());
+   a = a / ca;
+   b = b / cb;
+   T g = T(1), h = T(1);
+   while (b.degree() > 0) {
+      const int m = a.degree(), n = b.degree(), delta = m - n;
+      if (m % 2 && n % 2)
+         s = -s;
+      const static_poly<T, N> r = detail::pseudo_remainder(a, b, m, n);
+      if (!r)
+         return T(0);
+      a = b;
+      b = r / (g * detail::integer_power(h, delta));
+      g = a[a.degree()];
+      h = delta ? detail::integer_power(g, delta) / detail::integer_power(h, delta - 1) : h;
+   }
+   const int m = a.degree();
+   h = detail::integer_power(b[0], m) / detail::integer_power(h, m - 1);
+   return s * t * h;
+}
+
+#endif // NAM_GCD_HPP
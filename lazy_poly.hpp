@@ -0,0 +1,280 @@
+/*  Expression templates for static_poly: sums, differences and scalar
+ *  multiples computed in one pass over the coefficients.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_LAZY_POLY_HPP
+#define NAM_LAZY_POLY_HPP
+
+#include <type_traits> // decay_t, enable_if_t
+#include <utility> // forward
+#include "static_poly.hpp"
+
+template <class E>
+struct lazy_poly;
+
+namespace detail {
+   template <class P>
+   struct is_static_poly : std::false_type {};
+
+   template <class T, int N>
+   struct is_static_poly<static_poly<T, N> > : std::true_type {
+      static constexpr int size = N;
+   };
+
+   template <class P>
+   struct is_lazy_poly : std::false_type {};
+
+   template <class E>
+   struct is_lazy_poly<lazy_poly<E> > : std::true_type {};
+
+   // neither kind of polynomial: multiplies and adds to coefficients
+   template <class U>
+   using if_scalar = std::enable_if_t<!is_static_poly<std::decay_t<U> >::value
+                                      && !is_lazy_poly<std::decay_t<U> >::value>;
+
+   /* The nodes of an expression: each has the value_type and size of the
+    * static_poly it stands for, and its coefficient(i) for i < size. */
+
+   // a static_poly, held by reference if P is one (an lvalue), else by value
+   template <class P>
+   struct lazy_leaf {
+      typedef typename std::decay_t<P>::value_type value_type;
+      static constexpr int size = is_static_poly<std::decay_t<P> >::size;
+      P m_poly;
+
+      constexpr value_type coefficient(int i) const {
+         return i < size ? m_poly.m_data[i] : value_type(0);
+      }
+   };
+
+   template <class L, class R, bool subtract>
+   struct lazy_sum {
+      typedef typename L::value_type value_type;
+      static constexpr int size = L::size > R::size ? L::size : R::size;
+      L m_left;
+      R m_right;
+
+      constexpr value_type coefficient(int i) const {
+         return subtract ? m_left.coefficient(i) - m_right.coefficient(i)
+                         : m_left.coefficient(i) + m_right.coefficient(i);
+      }
+   };
+
+   // coefficients times a scalar, on the right, as static_poly's operator*= does
+   template <class E, class U>
+   struct lazy_scaled {
+      typedef typename E::value_type value_type;
+      static constexpr int size = E::size;
+      E m_expr;
+      U m_scalar;
+
+      constexpr value_type coefficient(int i) const {
+         return m_expr.coefficient(i) * m_scalar;
+      }
+   };
+
+   // a scalar added to or subtracted from the constant term
+   template <class E, class U, bool subtract>
+   struct lazy_shifted {
+      typedef typename E::value_type value_type;
+      static constexpr int size = E::size > 1 ? E::size : 1;
+      E m_expr;
+      U m_scalar;
+
+      constexpr value_type coefficient(int i) const {
+         return i ? m_expr.coefficient(i)
+              : subtract ? m_expr.coefficient(0) - m_scalar : m_expr.coefficient(0) + m_scalar;
+      }
+   };
+
+   template <class E>
+   struct lazy_negated {
+      typedef typename E::value_type value_type;
+      static constexpr int size = E::size;
+      E m_expr;
+
+      constexpr value_type coefficient(int i) const {
+         return m_expr.coefficient(i) * -1;
+      }
+   };
+
+   template <class P>
+   constexpr lazy_poly<lazy_leaf<P> > make_leaf(P&& p) {
+      return {{std::forward<P>(p)}};
+   }
+}
+
+/* An unevaluated linear combination of static_polys, from lazy(p) and the
+ * operators below.  Nothing is computed until it's converted to a static_poly
+ * (or eval()), which makes one pass over the coefficients, or evaluated at a
+ * point, which is one Horner pass computing each coefficient as it goes.
+ * Products, quotients and powers are not linear: they evaluate their operands
+ * and give the result as a lazy_poly again.
+ * Polynomials that are lvalues are held by reference, so keep them alive while
+ * the expression is used; the usual way is to write the whole expression in
+ * one initializer:
+ *    constexpr static_poly<int, 6> p = lazy(x) * x - 3 * lazy(x) + 2;
+ */
+template <class E>
+struct lazy_poly {
+   typedef typename E::value_type value_type;
+   static constexpr int size = E::size;
+   E m_expr;
+
+   constexpr value_type coefficient(int i) const {
+      return m_expr.coefficient(i);
+   }
+
+   constexpr static_poly<value_type, size> eval() const {
+      static_poly<value_type, size> p;
+      for (int i = 0; i < size; ++i)
+         p.m_data[i] = m_expr.coefficient(i);
+      return p;
+   }
+
+   constexpr operator static_poly<value_type, size>() const {
+      return eval();
+   }
+
+   // Horner's rule
+   constexpr value_type operator() (value_type z) const {
+      value_type sum = m_expr.coefficient(size - 1);
+      for (int i = size - 1; i > 0;) {
+         --i;
+         sum *= z;
+         sum += m_expr.coefficient(i);
+      }
+      return sum;
+   }
+};
+
+// the start of an expression
+template <class P, class = std::enable_if_t<detail::is_static_poly<std::decay_t<P> >::value> >
+constexpr auto lazy(P&& p) {
+   return detail::make_leaf(std::forward<P>(p));
+}
+
+template <class E1, class E2>
+constexpr lazy_poly<detail::lazy_sum<E1, E2, false> > operator + (const lazy_poly<E1>& a, const lazy_poly<E2>& b) {
+   return {{a.m_expr, b.m_expr}};
+}
+
+template <class E1, class E2>
+constexpr lazy_poly<detail::lazy_sum<E1, E2, true> > operator - (const lazy_poly<E1>& a, const lazy_poly<E2>& b) {
+   return {{a.m_expr, b.m_expr}};
+}
+
+/* With a static_poly: spelled out for lvalues and rvalues, rather than with a
+ * forwarding reference, to be more specialized than the static_poly operators
+ * with a scalar. */
+template <class E, class T, int N>
+constexpr auto operator + (const lazy_poly<E>& a, const static_poly<T, N>& b) {
+   return a + lazy(b);
+}
+
+template <class E, class T, int N>
+constexpr auto operator + (const lazy_poly<E>& a, static_poly<T, N>&& b) {
+   return a + lazy(std::move(b));
+}
+
+template <class E, class T, int N>
+constexpr auto operator - (const lazy_poly<E>& a, const static_poly<T, N>& b) {
+   return a - lazy(b);
+}
+
+template <class E, class T, int N>
+constexpr auto operator - (const lazy_poly<E>& a, static_poly<T, N>&& b) {
+   return a - lazy(std::move(b));
+}
+
+template <class T, int N, class E>
+constexpr auto operator + (const static_poly<T, N>& a, const lazy_poly<E>& b) {
+   return lazy(a) + b;
+}
+
+template <class T, int N, class E>
+constexpr auto operator + (static_poly<T, N>&& a, const lazy_poly<E>& b) {
+   return lazy(std::move(a)) + b;
+}
+
+template <class T, int N, class E>
+constexpr auto operator - (const static_poly<T, N>& a, const lazy_poly<E>& b) {
+   return lazy(a) - b;
+}
+
+template <class T, int N, class E>
+constexpr auto operator - (static_poly<T, N>&& a, const lazy_poly<E>& b) {
+   return lazy(std::move(a)) - b;
+}
+
+template <class E, class U, class = detail::if_scalar<U> >
+constexpr lazy_poly<detail::lazy_scaled<E, U> > operator * (const lazy_poly<E>& a, const U& b) {
+   return {{a.m_expr, b}};
+}
+
+template <class U, class E, class = detail::if_scalar<U> >
+constexpr lazy_poly<detail::lazy_scaled<E, U> > operator * (const U& a, const lazy_poly<E>& b) {
+   return {{b.m_expr, a}};
+}
+
+template <class E, class U, class = detail::if_scalar<U> >
+constexpr lazy_poly<detail::lazy_shifted<E, U, false> > operator + (const lazy_poly<E>& a, const U& b) {
+   return {{a.m_expr, b}};
+}
+
+template <class U, class E, class = detail::if_scalar<U> >
+constexpr lazy_poly<detail::lazy_shifted<E, U, false> > operator + (const U& a, const lazy_poly<E>& b) {
+   return {{b.m_expr, a}};
+}
+
+template <class E, class U, class = detail::if_scalar<U> >
+constexpr lazy_poly<detail::lazy_shifted<E, U, true> > operator - (const lazy_poly<E>& a, const U& b) {
+   return {{a.m_expr, b}};
+}
+
+template <class U, class E, class = detail::if_scalar<U> >
+constexpr auto operator - (const U& a, const lazy_poly<E>& b) {
+   return -b + a;
+}
+
+// Unary minus (negate).
+template <class E>
+constexpr lazy_poly<detail::lazy_negated<E> > operator - (const lazy_poly<E>& a) {
+   return {{a.m_expr}};
+}
+
+/* The rest evaluate their operands */
+
+template <class E1, class E2>
+constexpr auto operator * (const lazy_poly<E1>& a, const lazy_poly<E2>& b) {
+   return detail::make_leaf(a.eval() * b.eval());
+}
+
+template <class E, class T, int N>
+constexpr auto operator * (const lazy_poly<E>& a, const static_poly<T, N>& b) {
+   return detail::make_leaf(a.eval() * b);
+}
+
+template <class T, int N, class E>
+constexpr auto operator * (const static_poly<T, N>& a, const lazy_poly<E>& b) {
+   return detail::make_leaf(a * b.eval());
+}
+
+template <class E1, class E2>
+constexpr auto operator / (const lazy_poly<E1>& a, const lazy_poly<E2>& b) {
+   return detail::make_leaf(a.eval() / b.eval());
+}
+
+template <class E1, class E2>
+constexpr auto operator % (const lazy_poly<E1>& a, const lazy_poly<E2>& b) {
+   return detail::make_leaf(a.eval() % b.eval());
+}
+
+template <int exp, class E>
+constexpr auto power(const lazy_poly<E>& b) {
+   return detail::make_leaf(power<exp>(b.eval()));
+}
+
+#endif // NAM_LAZY_POLY_HPP
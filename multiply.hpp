@@ -0,0 +1,437 @@
+//  Multiplication kernels on coefficient arrays, shared by the polynomial types.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NAM_POLYNOMIAL_MULTIPLY_HPP
+#define NAM_POLYNOMIAL_MULTIPLY_HPP
+
+#include <cstdint> // uint32_t, uint64_t
+#include <type_traits> // is_integral, is_signed, make_unsigned
+
+/* Both factors need at least this many terms before Karatsuba multiplication
+ * is used in place of the schoolbook product. */
+#ifndef NAM_STATIC_POLY_KARATSUBA_THRESHOLD
+#  define NAM_STATIC_POLY_KARATSUBA_THRESHOLD 24
+#endif
+
+/* Both factors need at least this many terms before the number theoretic
+ * transform is used in place of Karatsuba, twice as many if the coefficients
+ * need two primes and four times as many for three. */
+#ifndef NAM_STATIC_POLY_NTT_THRESHOLD
+#  define NAM_STATIC_POLY_NTT_THRESHOLD 256
+#endif
+
+namespace detail {
+
+constexpr int karatsuba_threshold = NAM_STATIC_POLY_KARATSUBA_THRESHOLD < 2 ? 2
+                                  : NAM_STATIC_POLY_KARATSUBA_THRESHOLD;
+
+/* Karatsuba reassociates the sums of products, so it is only used where that
+ * can't change the result: exact (integral) coefficients. */
+template <class T>
+struct use_karatsuba : std::is_integral<T> {};
+
+/* The type the kernels do their arithmetic in for T.  Over an integral type
+ * that's the unsigned type, at least as wide as unsigned int: Karatsuba's
+ * sums (a0 + a1)(b0 + b1) can outgrow T even when the product doesn't, and
+ * arithmetic modulo 2^bits still ends with the exact product when it fits in
+ * T.  Values are kept in T in between, converted modulo 2^bits. */
+template <class T, bool = std::is_integral<T>::value>
+struct modular_ring {
+   typedef T type;
+};
+
+template <class T>
+struct modular_ring<T, true> {
+   typedef std::make_unsigned_t<decltype(T() + 0u)> type;
+};
+
+// x += y and x -= y in modular_ring<T>
+template <class T>
+constexpr void modular_add(T& x, const T& y) {
+   typedef typename modular_ring<T>::type U;
+   x = static_cast<T>(static_cast<U>(x) + static_cast<U>(y));
+}
+
+template <class T>
+constexpr void modular_sub(T& x, const T& y) {
+   typedef typename modular_ring<T>::type U;
+   x = static_cast<T>(static_cast<U>(x) - static_cast<U>(y));
+}
+
+/* out[0 .. na+nb-2] = a[0 .. na-1] * b[0 .. nb-1] */
+template <class T>
+constexpr void mul_schoolbook(const T* a, int na, const T* b, int nb, T* out) {
+   typedef typename modular_ring<T>::type U;
+   // one output coefficient at a time, so out can't alias the inner loop
+   for (int k = 0; k < na + nb - 1; ++k) {
+      U sum = U(0);
+      for (int i = k < nb ? 0 : k - nb + 1; i < na && i <= k; ++i)
+         sum += static_cast<U>(a[i]) * static_cast<U>(b[k - i]);
+      out[k] = static_cast<T>(sum);
+   }
+}
+
+/* out[0 .. min(2n-1, nout)-1] = a[0 .. n-1]^2, truncated to nout terms.  Each
+ * a[i] a[j] with i != j appears twice in a coefficient, so it is computed once
+ * and the sum doubled: about half the multiplications of mul_schoolbook.  That
+ * reassociates the sums too, so it is for exact coefficients (use_karatsuba),
+ * and it sums in modular_ring<T>, as twice a partial sum can outgrow T. */
+template <class T>
+constexpr void sqr_schoolbook(const T* a, int n, T* out, int nout) {
+   typedef typename modular_ring<T>::type U;
+   for (int k = 0; k < 2*n - 1 && k < nout; ++k) {
+      U sum = U(0);
+      int i = k < n ? 0 : k - n + 1, j = k - i;
+      for (; i < j; ++i, --j)
+         sum += static_cast<U>(a[i]) * static_cast<U>(a[j]);
+      sum += sum;
+      if (i == j)
+         sum += static_cast<U>(a[i]) * static_cast<U>(a[i]);
+      out[k] = static_cast<T>(sum);
+   }
+}
+
+/* Scratch space needed by mul_karatsuba for n terms. */
+constexpr int karatsuba_scratch(int n) {
+   return n < karatsuba_threshold ? 0
+        : 4 * (n - n / 2) - 1 + karatsuba_scratch(n - n / 2);
+}
+
+/* out[0 .. 2n-2] = a[0 .. n-1] * b[0 .. n-1], using karatsuba_scratch(n) of scratch.
+ * With a = a0 + x^h a1 and b = b0 + x^h b1,
+ * a*b = a0 b0 + x^h ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) + x^2h a1 b1,
+ * in modular_ring<T>. */
+template <class T>
+constexpr void mul_karatsuba(const T* a, const T* b, int n, T* out, T* scratch) {
+   if (n < karatsuba_threshold)
+      return mul_schoolbook(a, n, b, n, out);
+   const int h = n / 2, m = n - h; // m >= h
+   mul_karatsuba(a, b, h, out, scratch);                  // out[0 .. 2h-2] = a0 b0
+   out[2*h - 1] = T(0);
+   mul_karatsuba(a + h, b + h, m, out + 2*h, scratch);    // out[2h .. 2n-2] = a1 b1
+   T* sa = scratch;
+   T* sb = sa + m;
+   T* mid = sb + m;
+   for (int i = 0; i < m; ++i) {
+      sa[i] = a[h + i];
+      sb[i] = b[h + i];
+   }
+   for (int i = 0; i < h; ++i) {
+      modular_add(sa[i], a[i]);
+      modular_add(sb[i], b[i]);
+   }
+   mul_karatsuba(sa, sb, m, mid, mid + 2*m - 1);          // mid = (a0 + a1)(b0 + b1)
+   for (int i = 0; i < 2*h - 1; ++i)
+      modular_sub(mid[i], out[i]);
+   for (int i = 0; i < 2*m - 1; ++i)
+      modular_sub(mid[i], out[2*h + i]);
+   for (int i = 0; i < 2*m - 1; ++i)
+      modular_add(out[h + i], mid[i]);
+}
+
+/* out[0 .. 2n-2] = a[0 .. n-1]^2, using karatsuba_scratch(n) of scratch (it
+ * needs less).  As mul_karatsuba, with three squares:
+ * a^2 = a0^2 + x^h ((a0 + a1)^2 - a0^2 - a1^2) + x^2h a1^2, in modular_ring<T>. */
+template <class T>
+constexpr void sqr_karatsuba(const T* a, int n, T* out, T* scratch) {
+   if (n < karatsuba_threshold)
+      return sqr_schoolbook(a, n, out, 2*n - 1);
+   const int h = n / 2, m = n - h; // m >= h
+   sqr_karatsuba(a, h, out, scratch);                     // out[0 .. 2h-2] = a0^2
+   out[2*h - 1] = T(0);
+   sqr_karatsuba(a + h, m, out + 2*h, scratch);           // out[2h .. 2n-2] = a1^2
+   T* sa = scratch;
+   T* mid = sa + m;
+   for (int i = 0; i < m; ++i)
+      sa[i] = a[h + i];
+   for (int i = 0; i < h; ++i)
+      modular_add(sa[i], a[i]);
+   sqr_karatsuba(sa, m, mid, mid + 2*m - 1);              // mid = (a0 + a1)^2
+   for (int i = 0; i < 2*h - 1; ++i)
+      modular_sub(mid[i], out[i]);
+   for (int i = 0; i < 2*m - 1; ++i)
+      modular_sub(mid[i], out[2*h + i]);
+   for (int i = 0; i < 2*m - 1; ++i)
+      modular_add(out[h + i], mid[i]);
+}
+
+/* Scratch space needed by mul_general when neither factor exceeds n terms. */
+constexpr int mul_scratch(int n) {
+   return n + 2*n - 1 + karatsuba_scratch(n);
+}
+
+/* out[0 .. na+nb-2] = a[0 .. na-1] * b[0 .. nb-1], using mul_scratch(max(na, nb))
+ * of scratch.  The longer factor is cut into pieces as long as the shorter,
+ * and each piece multiplied by Karatsuba. */
+template <class T>
+constexpr void mul_general(const T* a, int na, const T* b, int nb, T* out, T* scratch) {
+   if (na < nb)
+      return mul_general(b, nb, a, na, out, scratch);
+   if (nb < karatsuba_threshold)
+      return mul_schoolbook(a, na, b, nb, out);
+   T* piece = scratch;
+   T* prod = piece + nb;
+   T* rest = prod + 2*nb - 1;
+   for (int i = 0; i < na + nb - 1; ++i)
+      out[i] = T(0);
+   for (int off = 0; off < na; off += nb) {
+      const int len = na - off < nb ? na - off : nb;
+      for (int i = 0; i < nb; ++i)
+         piece[i] = i < len ? a[off + i] : T(0);
+      mul_karatsuba(piece, b, nb, prod, rest);
+      for (int i = 0; i < len + nb - 1; ++i)
+         modular_add(out[off + i], prod[i]);
+   }
+}
+
+constexpr int ntt_threshold = NAM_STATIC_POLY_NTT_THRESHOLD;
+
+/* Products by number theoretic transform are computed modulo up to three
+ * primes below 2^30 and put back together by the Chinese remainder theorem.
+ * That's exact as long as the coefficients of the product can't outgrow the
+ * primes, which is checked from the sizes of the factors; when they could,
+ * mul_ntt declines and Karatsuba is used instead.
+ * The reconstruction works in 64 bits, so T can't be wider than that. */
+template <class T>
+struct use_ntt : std::integral_constant<bool, std::is_integral<T>::value
+                                              && sizeof(T) <= sizeof(std::uint64_t)> {};
+
+// p = c 2^k + 1, each with 3 as a primitive root
+constexpr std::uint32_t ntt_p0 = 998244353, // 119 * 2^23 + 1
+                        ntt_p1 = 167772161, //   5 * 2^25 + 1
+                        ntt_p2 = 469762049; //   7 * 2^26 + 1
+
+// The product of the first k primes exceeds 2^ntt_bits(k).
+constexpr int ntt_bits(int k) {
+   return k == 1 ? 29 : k == 2 ? 57 : 86;
+}
+
+template <std::uint32_t P>
+constexpr std::uint32_t mul_mod(std::uint32_t a, std::uint32_t b) {
+   return static_cast<std::uint32_t>(std::uint64_t(a) * b % P);
+}
+
+template <std::uint32_t P>
+constexpr std::uint32_t pow_mod(std::uint32_t b, std::uint32_t e) {
+   std::uint32_t r = 1;
+   for (; e; e >>= 1, b = mul_mod<P>(b, b))
+      if (e & 1)
+         r = mul_mod<P>(r, b);
+   return r;
+}
+
+template <std::uint32_t P>
+constexpr std::uint32_t inv_mod(std::uint32_t a) {
+   return pow_mod<P>(a, P - 2);
+}
+
+/* Montgomery multiplication modulo P, with R = 2^32: mont_mul(a, b) = a b / R.
+ * Multiplying by a constant kept as c R gives plain c a without a division. */
+template <std::uint32_t P>
+struct montgomery {
+   static constexpr std::uint32_t neg_inv() { // -1/P mod R, by Newton's iteration
+      std::uint32_t inv = P; // correct to 3 bits, as P is odd
+      for (int i = 0; i < 4; ++i)
+         inv *= 2 - P * inv;
+      return 0 - inv;
+   }
+
+   static constexpr std::uint32_t q = neg_inv();
+   static constexpr std::uint32_t r = static_cast<std::uint32_t>((std::uint64_t(1) << 32) % P);
+};
+
+// x mod P for -P <= x < P, with x wrapped to 32 bits; without branches, which
+// mispredict about half the time here
+template <std::uint32_t P>
+constexpr std::uint32_t reduce_signed(std::uint32_t x) {
+   return x + (P & (0 - (x >> 31)));
+}
+
+template <std::uint32_t P>
+constexpr std::uint32_t mont_mul(std::uint32_t a, std::uint32_t b) {
+   const std::uint64_t t = std::uint64_t(a) * b;
+   const std::uint32_t m = static_cast<std::uint32_t>(t) * montgomery<P>::q;
+   const std::uint32_t s = static_cast<std::uint32_t>((t + std::uint64_t(m) * P) >> 32);
+   return reduce_signed<P>(s - P);
+}
+
+/* roots[j] = w^j R mod P for j < len/2, w a primitive len-th root of unity. */
+template <std::uint32_t P>
+constexpr void ntt_roots(std::uint32_t* roots, int len) {
+   const std::uint32_t w = mul_mod<P>(pow_mod<P>(3, (P - 1) / len), montgomery<P>::r);
+   roots[0] = montgomery<P>::r;
+   for (int j = 1; j < len / 2; ++j)
+      roots[j] = mont_mul<P>(roots[j - 1], w);
+}
+
+/* In-place transform of f[0 .. len-1] modulo P (len a power of two), with the
+ * table from ntt_roots. */
+template <std::uint32_t P>
+constexpr void ntt(std::uint32_t* f, int len, const std::uint32_t* roots) {
+   for (int i = 1, j = 0; i < len; ++i) { // bit reversal permutation
+      int bit = len >> 1;
+      for (; j & bit; bit >>= 1)
+         j ^= bit;
+      j ^= bit;
+      if (i < j) {
+         const std::uint32_t t = f[i];
+         f[i] = f[j];
+         f[j] = t;
+      }
+   }
+   for (int m = 1; m < len; m <<= 1) {
+      const int stride = len / (2 * m);
+      for (int s = 0; s < len; s += 2 * m)
+         for (int k = 0; k < m; ++k) {
+            const std::uint32_t u = f[s + k], v = mont_mul<P>(f[s + k + m], roots[k * stride]);
+            f[s + k] = reduce_signed<P>(u + v - P);
+            f[s + k + m] = reduce_signed<P>(u - v);
+         }
+   }
+}
+
+template <class T>
+constexpr std::uint64_t magnitude(T x, std::true_type /* signed */) {
+   return x < T(0) ? std::uint64_t(0) - static_cast<std::uint64_t>(x)
+                   : static_cast<std::uint64_t>(x);
+}
+
+template <class T>
+constexpr std::uint64_t magnitude(T x, std::false_type) {
+   return static_cast<std::uint64_t>(x);
+}
+
+template <std::uint32_t P, class T>
+constexpr std::uint32_t residue(T x) {
+   const std::uint32_t r = static_cast<std::uint32_t>(magnitude(x, std::is_signed<T>()) % P);
+   return x < T(0) && r ? P - r : r;
+}
+
+constexpr int bit_length(std::uint64_t m) {
+   int bits = 0;
+   for (; m; m >>= 1)
+      ++bits;
+   return bits;
+}
+
+// number of bits needed for the largest magnitude among a[0 .. n-1]
+template <class T>
+constexpr int bit_length(const T* a, int n) {
+   std::uint64_t m = 0;
+   for (int i = 0; i < n; ++i) {
+      const std::uint64_t v = magnitude(a[i], std::is_signed<T>());
+      if (m < v)
+         m = v;
+   }
+   return bit_length(m);
+}
+
+/* f[0 .. len-1] = a * b modulo P, using g[0 .. len-1] and roots[0 .. len/2-1]
+ * as scratch; len is a power of two no less than na + nb - 1.  A square
+ * (b is a) takes one forward transform less. */
+template <std::uint32_t P, class T>
+constexpr void ntt_product(const T* a, int na, const T* b, int nb, int len,
+                           std::uint32_t* f, std::uint32_t* g, std::uint32_t* roots) {
+   const bool square = a == b && na == nb;
+   for (int i = 0; i < len; ++i) {
+      f[i] = i < na ? residue<P>(a[i]) : 0;
+      if (!square)
+         g[i] = i < nb ? residue<P>(b[i]) : 0;
+   }
+   ntt_roots<P>(roots, len);
+   ntt<P>(f, len, roots);
+   if (!square)
+      ntt<P>(g, len, roots);
+   for (int i = 0; i < len; ++i)
+      f[i] = mont_mul<P>(f[i], square ? f[i] : g[i]); // a b / R
+   // the inverse transform is the forward one with the indices negated, and
+   // a division by len; scaling by R^2 / len also takes out the 1/R above
+   ntt<P>(f, len, roots);
+   for (int i = 1, j = len - 1; i < j; ++i, --j) {
+      const std::uint32_t t = f[i];
+      f[i] = f[j];
+      f[j] = t;
+   }
+   const std::uint32_t scale = mul_mod<P>(mul_mod<P>(montgomery<P>::r, montgomery<P>::r),
+                                          inv_mod<P>(static_cast<std::uint32_t>(len)));
+   for (int i = 0; i < len; ++i)
+      f[i] = mont_mul<P>(f[i], scale);
+}
+
+/* The integer with residues r[0 .. primes-1], by Garner's algorithm: the
+ * mixed radix digits t with value t0 + p0 t1 + p0 p1 t2.  For signed T the
+ * value is taken in (-M/2, M/2], where M is the product of the primes. */
+template <class T>
+constexpr T crt_coefficient(const std::uint32_t* r, int primes) {
+   std::uint32_t t[3] = {r[0], 0, 0};
+   if (primes > 1)
+      t[1] = mul_mod<ntt_p1>(r[1] + ntt_p1 - t[0] % ntt_p1, inv_mod<ntt_p1>(ntt_p0 % ntt_p1));
+   if (primes > 2) {
+      const std::uint32_t s = (t[0] + mul_mod<ntt_p2>(ntt_p0 % ntt_p2, t[1])) % ntt_p2;
+      t[2] = mul_mod<ntt_p2>(r[2] + ntt_p2 - s,
+                             inv_mod<ntt_p2>(mul_mod<ntt_p2>(ntt_p0 % ntt_p2, ntt_p1 % ntt_p2)));
+   }
+   const std::uint32_t p[3] = {ntt_p0, ntt_p1, ntt_p2};
+   // the primes are odd, so floor(M/2) has mixed radix digits (p_k - 1)/2
+   bool negative = false;
+   for (int k = primes - 1; k >= 0; --k)
+      if (t[k] != (p[k] - 1) / 2) {
+         negative = std::is_signed<T>::value && t[k] > (p[k] - 1) / 2;
+         break;
+      }
+   // modulo 2^64 from here on
+   std::uint64_t value = 0, radix = 1;
+   for (int k = 0; k < primes; ++k) {
+      value += radix * t[k];
+      radix *= p[k];
+   }
+   return negative ? static_cast<T>(-static_cast<T>(radix - value)) : static_cast<T>(value);
+}
+
+/* Length of the transforms for products of up to n terms. */
+constexpr int ntt_length(int n) {
+   int len = 1;
+   while (len < n)
+      len <<= 1;
+   return len;
+}
+
+/* out[0 .. na+nb-2] = a[0 .. na-1] * b[0 .. nb-1] by number theoretic transform,
+ * if both factors are long enough and the result is sure to be exact; returns
+ * whether it did.  Cap bounds na and nb. */
+template <int Cap, class T>
+constexpr bool mul_ntt(const T* a, int na, const T* b, int nb, T* out, std::true_type) {
+   const int n = na < nb ? na : nb;
+   if (n < ntt_threshold)
+      return false;
+   // |coefficient of a * b| < 2^bits, and one more bit for the sign
+   const int bits = bit_length(a, na) + bit_length(b, nb) + bit_length(std::uint64_t(n))
+                  + (std::is_signed<T>::value ? 1 : 0);
+   const int primes = bits <= ntt_bits(1) ? 1 : bits <= ntt_bits(2) ? 2 : bits <= ntt_bits(3) ? 3 : 0;
+   if (!primes || n < ntt_threshold << (primes - 1))
+      return false;
+   constexpr int max_len = ntt_length(2 * Cap - 1);
+   const int len = ntt_length(na + nb - 1);
+   std::uint32_t res[3 * max_len] {}, scratch[max_len] {}, roots[max_len / 2 + 1] {};
+   ntt_product<ntt_p0>(a, na, b, nb, len, res, scratch, roots);
+   if (primes > 1)
+      ntt_product<ntt_p1>(a, na, b, nb, len, res + max_len, scratch, roots);
+   if (primes > 2)
+      ntt_product<ntt_p2>(a, na, b, nb, len, res + 2 * max_len, scratch, roots);
+   for (int i = 0; i < na + nb - 1; ++i) {
+      const std::uint32_t r[3] = {res[i], res[max_len + i], res[2 * max_len + i]};
+      out[i] = crt_coefficient<T>(r, primes);
+   }
+   return true;
+}
+
+template <int Cap, class T>
+constexpr bool mul_ntt(const T*, int, const T*, int, T*, std::false_type) {
+   return false;
+}
+
+} // namespace detail
+
+#endif // NAM_POLYNOMIAL_MULTIPLY_HPP
@@ -0,0 +1,218 @@
+/*  Evaluation of one polynomial at many points by a subproduct tree.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_MULTIPOINT_HPP
+#define NAM_MULTIPOINT_HPP
+
+#include <algorithm> // min
+#include <cstddef> // size_t
+#include <limits> // numeric_limits
+#include <memory> // allocator_traits
+#include <type_traits> // integral_constant, is_same
+#include <vector>
+#include "dynamic_poly.hpp"
+#include "evaluate_many.hpp"
+
+/* The subproduct tree is used once both the number of terms of the polynomial
+ * and the number of points reach the threshold; its leaves hold up to the leaf
+ * size of points, which are evaluated by Horner's rule.  Over types that
+ * aren't exact (by std::numeric_limits) the field threshold applies instead,
+ * and by default the tree is never used: in floating point the remainders
+ * lose all accuracy a few levels down (on 256 Chebyshev points in [-1, 1] the
+ * values come out around 1e124), so only lower it for points and
+ * coefficients known to be tame. */
+#ifndef NAM_STATIC_POLY_MULTIPOINT_THRESHOLD
+#  define NAM_STATIC_POLY_MULTIPOINT_THRESHOLD 1024
+#endif
+
+#ifndef NAM_STATIC_POLY_MULTIPOINT_FIELD_THRESHOLD
+#  define NAM_STATIC_POLY_MULTIPOINT_FIELD_THRESHOLD (1 << 30)
+#endif
+
+#ifndef NAM_STATIC_POLY_MULTIPOINT_LEAF_SIZE
+#  define NAM_STATIC_POLY_MULTIPOINT_LEAF_SIZE 32
+#endif
+
+namespace detail {
+   template <class T>
+   constexpr int multipoint_threshold() {
+      return std::numeric_limits<T>::is_exact ? NAM_STATIC_POLY_MULTIPOINT_THRESHOLD
+                                              : NAM_STATIC_POLY_MULTIPOINT_FIELD_THRESHOLD;
+   }
+
+   constexpr int multipoint_leaf_size = NAM_STATIC_POLY_MULTIPOINT_LEAF_SIZE < 1 ? 1
+                                      : NAM_STATIC_POLY_MULTIPOINT_LEAF_SIZE;
+
+   // out[i] = the polynomial of the given number of terms at xs[i], W points at a time
+   template <class T, int W>
+   void horner_many(const T* a, int terms, const T* xs, T* out, std::size_t n,
+                    const std::integral_constant<int, W>*) {
+      const std::size_t blocked = n - n % W;
+      std::size_t i = 0;
+      for (; i < blocked; i += W) {
+         lanes<T, W> x;
+         for (int l = 0; l < W; ++l)
+            x.set(l, xs[i + l]);
+         const lanes<T, W> y = evaluate_polynomial(a, x, terms);
+         for (int l = 0; l < W; ++l)
+            out[i + l] = y[l];
+      }
+      for (; i < n; ++i) // scalar tail
+         out[i] = evaluate_polynomial(a, xs[i], terms);
+   }
+
+   template <class T>
+   void horner_many(const T* a, int terms, const T* xs, T* out, std::size_t n,
+                    const std::integral_constant<int, 1>*) {
+      for (std::size_t i = 0; i < n; ++i)
+         out[i] = evaluate_polynomial(a, xs[i], terms);
+   }
+
+   template <class T>
+   void horner_many(const T* a, int terms, const T* xs, T* out, std::size_t n) {
+      typedef std::integral_constant<int, simd_lanes<T>()> tag_type;
+      horner_many(a, terms, xs, out, n, static_cast<tag_type const*>(0));
+   }
+
+   /* The products of (x - xs[i]) over the points below each node: level 0
+    * has one per leaf of `leaf` points (the last may have fewer), and each
+    * level above multiplies pairs of the one below, an odd one out moving up
+    * as it is.  The root is the last node. */
+   template <class T, class Alloc>
+   struct subproduct_tree {
+      typedef dynamic_poly<T, Alloc> poly;
+
+      std::vector<poly> m_nodes;
+      std::vector<std::size_t> m_level; // index in m_nodes of the first node of each level
+      std::size_t m_leaf;
+
+      subproduct_tree(const T* xs, std::size_t n, std::size_t leaf, const Alloc& alloc)
+      : m_leaf(leaf) {
+         std::size_t width = (n + leaf - 1) / leaf;
+         m_nodes.reserve(2 * width);
+         m_level.push_back(0);
+         poly linear({T(0), T(1)}, alloc), prod(alloc);
+         for (std::size_t b = 0; b < n; b += leaf) {
+            poly node(T(1), alloc);
+            for (std::size_t i = b; i < n && i < b + leaf; ++i) {
+               linear.set(0, -xs[i]);
+               multiply(node, linear, prod);
+               swap(node, prod);
+            }
+            m_nodes.push_back(std::move(node));
+         }
+         while (width > 1) {
+            const std::size_t first = m_level.back();
+            m_level.push_back(m_nodes.size());
+            for (std::size_t j = 0; j + 1 < width; j += 2) {
+               multiply(m_nodes[first + j], m_nodes[first + j + 1], prod);
+               m_nodes.push_back(prod);
+            }
+            if (width & 1)
+               m_nodes.push_back(m_nodes[first + width - 1]);
+            width = (width + 1) / 2;
+         }
+      }
+
+      int levels() const {
+         return int(m_level.size());
+      }
+
+      // the number of nodes on level
+      std::size_t width(int level) const {
+         return (level + 1 < levels() ? m_level[level + 1] : m_nodes.size()) - m_level[level];
+      }
+
+      const poly& node(int level, std::size_t j) const {
+         return m_nodes[m_level[level] + j];
+      }
+   };
+
+   /* r is the polynomial reduced modulo node j of level: reduce it modulo the
+    * children on down to the leaves, and evaluate it there.  rem[level - 1]
+    * and q are the scratch of the level below. */
+   template <class T, class Alloc>
+   void remainder_tree(const subproduct_tree<T, Alloc>& tree, int level, std::size_t j,
+                       const dynamic_poly<T, Alloc>& r, std::vector<dynamic_poly<T, Alloc> >& rem,
+                       dynamic_poly<T, Alloc>& q, const T* xs, T* out, std::size_t n) {
+      if (level == 0) {
+         const std::size_t first = j * tree.m_leaf;
+         const std::size_t count = std::min(tree.m_leaf, n - first);
+         return horner_many(r.data().first, r.size(), xs + first, out + first, count);
+      }
+      for (std::size_t c = 2 * j; c < 2 * j + 2 && c < tree.width(level - 1); ++c) {
+         const dynamic_poly<T, Alloc>& m = tree.node(level - 1, c);
+         if (r.degree() < m.degree()) {
+            remainder_tree(tree, level - 1, c, r, rem, q, xs, out, n);
+         } else {
+            quotient_remainder(r, m, q, rem[level - 1]);
+            remainder_tree(tree, level - 1, c, rem[level - 1], rem, q, xs, out, n);
+         }
+      }
+   }
+
+   // out[i] = poly(xs[i]), for the n points tree was built on
+   template <class T, class Alloc>
+   void tree_evaluate(const subproduct_tree<T, Alloc>& tree, const dynamic_poly<T, Alloc>& poly,
+                      const T* xs, T* out, std::size_t n) {
+      std::vector<dynamic_poly<T, Alloc> > rem(tree.levels(), dynamic_poly<T, Alloc>(poly.get_allocator()));
+      dynamic_poly<T, Alloc> q(poly.get_allocator());
+      const int top = tree.levels() - 1;
+      const dynamic_poly<T, Alloc>& root = tree.node(top, 0);
+      if (poly.degree() < root.degree())
+         return remainder_tree(tree, top, 0, poly, rem, q, xs, out, n);
+      quotient_remainder(poly, root, q, rem[top]);
+      remainder_tree(tree, top, 0, rem[top], rem, q, xs, out, n);
+   }
+
+   template <class T, class Alloc>
+   void multipoint_tree(const dynamic_poly<T, Alloc>& poly, const T* xs, T* out, std::size_t n, std::true_type /* T is its newton_ring */) {
+      const subproduct_tree<T, Alloc> tree(xs, n, multipoint_leaf_size, poly.get_allocator());
+      tree_evaluate(tree, poly, xs, out, n);
+   }
+
+   /* Other integral types go through the tree in their newton_ring, as Newton
+    * division does: the products of the tree outgrow T even when the values
+    * don't, and unsigned arithmetic keeps them right modulo 2^bits. */
+   template <class T, class Alloc>
+   void multipoint_tree(const dynamic_poly<T, Alloc>& poly, const T* xs, T* out, std::size_t n, std::false_type) {
+      typedef typename newton_ring<T>::type U;
+      typedef typename std::allocator_traits<Alloc>::template rebind_alloc<U> UAlloc;
+      const UAlloc alloc(poly.get_allocator());
+      const dynamic_poly<U, UAlloc> upoly(poly.data().first, poly.data().first + poly.size(), alloc);
+      const std::vector<U, UAlloc> uxs(xs, xs + n, alloc);
+      std::vector<U, UAlloc> uout(n, U(0), alloc);
+      multipoint_tree(upoly, uxs.data(), uout.data(), n, std::true_type());
+      for (std::size_t i = 0; i < n; ++i)
+         out[i] = static_cast<T>(uout[i]);
+   }
+}
+
+/* Evaluate poly at xs[0], ..., xs[n-1], storing the values in out[0], ...,
+ * out[n-1].  Reduces poly modulo the products of (x - xs[i]) of a subproduct
+ * tree over the points, down to leaves of a few points each, where the
+ * remainders are evaluated by Horner's rule: O(n log² n) operations with
+ * Karatsuba products and Newton division, against O(n d) for Horner's rule on
+ * a polynomial of degree d.  Below the threshold (above) it's Horner's rule
+ * throughout, a vector register's worth of points at a time.
+ * Over an integral type the tree needs the values to fit in T; it works modulo
+ * 2^bits in the unsigned type, so the products in between may wrap. */
+template <class T, class Alloc>
+void multipoint_evaluate(const dynamic_poly<T, Alloc>& poly, const T* xs, T* out, std::size_t n) {
+   const int threshold = detail::multipoint_threshold<T>();
+   if (poly.size() < threshold || n < std::size_t(threshold))
+      return detail::horner_many(poly.data().first, poly.size(), xs, out, n);
+   detail::multipoint_tree(poly, xs, out, n, std::is_same<typename detail::newton_ring<T>::type, T>());
+}
+
+template <class T, int N>
+void multipoint_evaluate(const static_poly<T, N>& poly, const T* xs, T* out, std::size_t n) {
+   const int threshold = detail::multipoint_threshold<T>();
+   if (N < threshold || n < std::size_t(threshold) || poly.degree() + 1 < threshold)
+      return evaluate_many(poly, xs, out, n);
+   multipoint_evaluate(dynamic_poly<T>(poly), xs, out, n);
+}
+
+#endif // NAM_MULTIPOINT_HPP
@@ -0,0 +1,164 @@
+/*  A memory pool for the temporaries of dynamic_poly computations.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_POLY_ARENA_HPP
+#define NAM_POLY_ARENA_HPP
+
+#include <cassert>
+#include <cstddef> // size_t, max_align_t
+#include <new> // operator new
+#include "dynamic_poly.hpp"
+
+/* What a poly_arena has done so far.  blocks counts the calls to operator
+ * new, so once a computation has run and it stops changing, running it again
+ * doesn't touch the heap. */
+struct poly_arena_stats {
+   std::size_t blocks = 0;        // taken from the heap
+   std::size_t block_bytes = 0;   // in those blocks
+   std::size_t allocations = 0;   // served to allocators
+   std::size_t deallocations = 0;
+   std::size_t bytes_in_use = 0;  // by chunk size
+   std::size_t peak_bytes_in_use = 0;
+};
+
+/* Memory in chunks of a power of two times the fundamental alignment, cut from
+ * blocks obtained from operator new, of doubling size.  Freed chunks go to a
+ * free list per chunk size and are handed out again before any new memory is
+ * cut, so a computation that repeats, as a loop over the same expression does,
+ * settles on a set of chunks and stops allocating.  The blocks are only given
+ * back when the arena is destroyed.  Not thread safe: one arena per thread. */
+struct poly_arena {
+   static constexpr std::size_t grain = alignof(std::max_align_t);
+   static constexpr int classes = 48;
+
+   struct block {
+      block* next;
+   };
+   struct free_chunk {
+      free_chunk* next;
+   };
+
+   block* m_blocks;
+   char* m_next;        // uncut memory of the newest block
+   std::size_t m_left;
+   std::size_t m_block_bytes; // of the next block
+   free_chunk* m_free[classes];
+   poly_arena_stats m_stats;
+
+   explicit poly_arena(std::size_t first_block_bytes = 1 << 16)
+   : m_blocks(nullptr), m_next(nullptr), m_left(0), m_block_bytes(first_block_bytes), m_free{} {}
+
+   poly_arena(const poly_arena&) = delete;
+   poly_arena& operator =(const poly_arena&) = delete;
+
+   ~poly_arena() {
+      assert(m_stats.bytes_in_use == 0 && "polynomials outlived their arena");
+      while (m_blocks) {
+         block* b = m_blocks;
+         m_blocks = b->next;
+         ::operator delete(b);
+      }
+   }
+
+   const poly_arena_stats& stats() const {
+      return m_stats;
+   }
+
+   // the class of chunk, of grain << class bytes, that holds bytes
+   static int size_class(std::size_t bytes) {
+      int k = 0;
+      while ((grain << k) < bytes)
+         ++k;
+      return k;
+   }
+
+   void* allocate(std::size_t bytes) {
+      const int k = size_class(bytes);
+      assert(k < classes);
+      const std::size_t chunk = grain << k;
+      ++m_stats.allocations;
+      m_stats.bytes_in_use += chunk;
+      if (m_stats.peak_bytes_in_use < m_stats.bytes_in_use)
+         m_stats.peak_bytes_in_use = m_stats.bytes_in_use;
+      if (free_chunk* c = m_free[k]) {
+         m_free[k] = c->next;
+         return c;
+      }
+      if (m_left < chunk)
+         add_block(chunk);
+      void* p = m_next;
+      m_next += chunk;
+      m_left -= chunk;
+      return p;
+   }
+
+   void deallocate(void* p, std::size_t bytes) {
+      const int k = size_class(bytes);
+      ++m_stats.deallocations;
+      m_stats.bytes_in_use -= grain << k;
+      free_chunk* c = static_cast<free_chunk*>(p);
+      c->next = m_free[k];
+      m_free[k] = c;
+   }
+
+   // a new block with room for chunk; what's left of the last one goes unused
+   void add_block(std::size_t chunk) {
+      const std::size_t header = (sizeof(block) + grain - 1) / grain * grain;
+      while (m_block_bytes < header + chunk)
+         m_block_bytes *= 2;
+      block* b = static_cast<block*>(::operator new(m_block_bytes));
+      b->next = m_blocks;
+      m_blocks = b;
+      m_next = reinterpret_cast<char*>(b) + header;
+      m_left = m_block_bytes - header;
+      ++m_stats.blocks;
+      m_stats.block_bytes += m_block_bytes;
+      m_block_bytes *= 2;
+   }
+};
+
+/* A standard allocator drawing from a poly_arena, which must outlive it and
+ * everything it allocates.  Allocators of the same arena compare equal, so
+ * dynamic_polys on one arena move by handing over their storage. */
+template <class T>
+struct arena_allocator {
+   typedef T value_type;
+
+   poly_arena* m_arena;
+
+   explicit arena_allocator(poly_arena& arena) noexcept : m_arena(&arena) {}
+
+   template <class U>
+   arena_allocator(const arena_allocator<U>& a) noexcept : m_arena(a.m_arena) {}
+
+   T* allocate(std::size_t n) {
+      static_assert(alignof(T) <= poly_arena::grain, "overaligned coefficients");
+      return static_cast<T*>(m_arena->allocate(n * sizeof(T)));
+   }
+
+   void deallocate(T* p, std::size_t n) {
+      m_arena->deallocate(p, n * sizeof(T));
+   }
+};
+
+template <class T, class U>
+bool operator == (const arena_allocator<T>& a, const arena_allocator<U>& b) {
+   return a.m_arena == b.m_arena;
+}
+
+template <class T, class U>
+bool operator != (const arena_allocator<T>& a, const arena_allocator<U>& b) {
+   return !(a == b);
+}
+
+/* dynamic_poly on an arena:
+ *    poly_arena arena;
+ *    arena_poly<int> x({0, 1}, arena_allocator<int>(arena));
+ * All the temporaries of an expression on x take their storage from the arena
+ * too, as results get the allocator of their first operand. */
+template <class T>
+using arena_poly = dynamic_poly<T, arena_allocator<T> >;
+
+#endif // NAM_POLY_ARENA_HPP
@@ -0,0 +1,229 @@
+//  Unrolled polynomial evaluation schemes for any compile-time size.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NAM_POLYNOMIAL_SCHEMES_HPP
+#define NAM_POLYNOMIAL_SCHEMES_HPP
+
+#include <cstddef> // size_t
+#include <type_traits> // conditional_t, integral_constant
+#include <utility> // declval
+
+/* Horner chains are unrolled up to this many terms, and loop beyond. */
+#ifndef NAM_STATIC_POLY_UNROLL_LIMIT
+#  define NAM_STATIC_POLY_UNROLL_LIMIT 64
+#endif
+
+/* Evaluation schemes, used as policy arguments: evaluate_polynomial<Scheme>(a, x). */
+
+/* K-th order Horner: K interleaved Horner chains in x^K, combined by a short
+ * Horner chain in x.  K = 1 is the plain Horner rule; K = 2 is the second order
+ * rule, which is what evaluate_polynomial(a, x) uses from five terms up. */
+template <int K>
+struct horner_scheme {
+   static_assert(K > 0, "Horner order must be positive");
+};
+
+/* Estrin's scheme: a binary tree of multiply-adds with x, x^2, x^4, ... */
+struct estrin_scheme {};
+
+/* Whichever of the above has the shortest dependency chain for the size. */
+struct auto_scheme {};
+
+namespace detail {
+
+template <int n>
+using int_tag = const std::integral_constant<int, n>*;
+
+template <int n>
+constexpr int_tag<n> make_int_tag() {
+   return nullptr;
+}
+
+// Horner's rule in y over a[0], a[Step], a[2*Step], ... (Count terms).
+// The offset is left out of the template arguments so that instantiations
+// are shared between chains and sizes.
+template <class R, int Step, class T, class Y, int Count>
+constexpr R horner_chain(const T* a, const Y& y, int_tag<Count>);
+
+template <class R, int Step, class T, class Y>
+constexpr R horner_chain_imp(const T* a, const Y&, int_tag<1>, std::false_type) {
+   return static_cast<R>(a[0]);
+}
+
+template <class R, int Step, class T, class Y, int Count>
+constexpr R horner_chain_imp(const T* a, const Y& y, int_tag<Count>, std::false_type) {
+   return horner_chain<R, Step>(a + Step, y, make_int_tag<Count - 1>()) * y + a[0];
+}
+
+// Longer chains are a loop, associating the same way: unrolled, they would
+// nest a call per term, past the compilers' template and constexpr depths.
+template <class R, int Step, class T, class Y, int Count>
+constexpr R horner_chain_imp(const T* a, const Y& y, int_tag<Count>, std::true_type) {
+   R sum = static_cast<R>(a[(Count - 1) * Step]);
+   for (int i = Count - 1; i > 0;) {
+      --i;
+      sum = sum * y + a[i * Step];
+   }
+   return sum;
+}
+
+template <class R, int Step, class T, class Y, int Count>
+constexpr R horner_chain(const T* a, const Y& y, int_tag<Count> n) {
+   return horner_chain_imp<R, Step>(a, y, n, std::integral_constant<bool, (Count > NAM_STATIC_POLY_UNROLL_LIMIT)>());
+}
+
+// Combine chains J, J + 1, ..., K - 1 (Rem = K - 1 - J) by Horner's rule in x.
+template <class R, int N, int K, int J, class T, class V>
+constexpr R horner_combine(const T* a, const V&, const V& xk, int_tag<0>) {
+   return horner_chain<R, K>(a + J, xk, make_int_tag<(N - J - 1) / K + 1>());
+}
+
+template <class R, int N, int K, int J, class T, class V, int Rem>
+constexpr R horner_combine(const T* a, const V& x, const V& xk, int_tag<Rem>) {
+   return horner_combine<R, N, K, J + 1>(a, x, xk, make_int_tag<Rem - 1>()) * x
+        + horner_chain<R, K>(a + J, xk, make_int_tag<(N - J - 1) / K + 1>());
+}
+
+// x^k for small k > 0, by squaring
+template <class V>
+constexpr V small_power(const V& x, int k) {
+   return k == 1 ? x
+        : k % 2  ? small_power(x, k - 1) * x
+        : small_power(x * x, k / 2);
+}
+
+template <class T, class V>
+using scheme_result_t = decltype(std::declval<const T&>() * std::declval<const V&>());
+
+// Horner of order K; the order can't usefully exceed the number of terms.
+template <int N, int K, class T, class V>
+constexpr V evaluate_horner(const T* a, const V& x) {
+   constexpr int k = K < N ? K : N;
+   return static_cast<V>(horner_combine<scheme_result_t<T, V>, N, k, 0>(
+                            a, x, small_power(x, k), make_int_tag<k - 1>()));
+}
+
+template <int N, class T, class V>
+constexpr V evaluate_horner2(const T* a, const V& x, int_tag<0> /* N == 2 */) {
+   return evaluate_horner<N, 1>(a, x);
+}
+
+template <int N, class T, class V>
+constexpr V evaluate_horner2(const T* a, const V& x, int_tag<1> /* N odd */) {
+   typedef scheme_result_t<T, V> R;
+   V x2 = x * x;
+   return static_cast<V>(horner_chain<R, 2>(a, x2, make_int_tag<(N + 1) / 2>())
+                       + horner_chain<R, 2>(a + 1, x2, make_int_tag<(N - 1) / 2>()) * x);
+}
+
+template <int N, class T, class V>
+constexpr V evaluate_horner2(const T* a, const V& x, int_tag<2> /* N even */) {
+   typedef scheme_result_t<T, V> R;
+   V x2 = x * x;
+   return static_cast<V>(horner_chain<R, 2>(a + 1, x2, make_int_tag<N / 2>()) * x
+                       + horner_chain<R, 2>(a + 2, x2, make_int_tag<N / 2 - 1>()) * x2 + a[0]);
+}
+
+template <class T, class V, int N, int K>
+constexpr V evaluate_scheme_imp(const T* a, const V& x, int_tag<N>, const horner_scheme<K>*) {
+   return evaluate_horner<N, K>(a, x);
+}
+
+/* Second order Horner is spelled out to associate exactly like the machine
+ * generated kernels of Boost's polynomial_horner2_20.hpp, so results agree
+ * with Boost and with earlier versions of this library. */
+template <class T, class V, int N>
+constexpr V evaluate_scheme_imp(const T* a, const V& x, int_tag<N>, const horner_scheme<2>*) {
+   return evaluate_horner2<N>(a, x, make_int_tag<N == 2 ? 0 : 2 - N % 2>());
+}
+
+// Estrin's scheme over a[0], ..., a[Len - 1]; xp[k] is x^(2^k).
+template <class R, class T, class V>
+constexpr R estrin(const T* a, const V*, int_tag<1>) {
+   return static_cast<R>(a[0]);
+}
+
+constexpr int floor_log2(int n) {
+   int k = 0;
+   while (n >>= 1)
+      ++k;
+   return k;
+}
+
+constexpr int ceil_log2(int n) {
+   return n > 1 ? floor_log2(n - 1) + 1 : 0;
+}
+
+template <class R, class T, class V, int Len>
+constexpr R estrin(const T* a, const V* xp, int_tag<Len>) {
+   // split off the largest power of two below Len, so the low half is a full tree
+   constexpr int k = floor_log2(Len - 1), m = 1 << k;
+   return estrin<R>(a + m, xp, make_int_tag<Len - m>()) * xp[k]
+        + estrin<R>(a, xp, make_int_tag<m>());
+}
+
+template <class T, class V, int N>
+constexpr V evaluate_scheme_imp(const T* a, const V& x, int_tag<N>, const estrin_scheme*) {
+   V xp[ceil_log2(N)] = {x};
+   for (int k = 1; k < ceil_log2(N); ++k)
+      xp[k] = xp[k - 1] * xp[k - 1];
+   return static_cast<V>(estrin<scheme_result_t<T, V> >(a, xp, make_int_tag<N>()));
+}
+
+/* Length of the critical path, in dependent multiply-adds, of each scheme. */
+constexpr int horner_latency(int n, int k) {
+   if (k > n)
+      k = n;
+   return k == 1 ? n - 1
+                 : ceil_log2(k) + (n + k - 1) / k - 1 + k - 1;
+}
+
+constexpr int max_of(int a, int b) {
+   return a < b ? b : a;
+}
+
+constexpr int estrin_latency(int n) {
+   if (n <= 1)
+      return 0;
+   const int k = floor_log2(n - 1), m = 1 << k;
+   // x^m takes k squarings, alongside the two halves
+   return max_of(max_of(estrin_latency(n - m), k), estrin_latency(m)) + 1;
+}
+
+/* Ties go to the scheme doing fewer multiplications, i.e. the earlier one. */
+template <int N>
+struct fastest_scheme {
+   static constexpr int h1 = horner_latency(N, 1), h2 = horner_latency(N, 2),
+                        h4 = horner_latency(N, 4), e = estrin_latency(N);
+   typedef std::conditional_t<(h1 <= h2 && h1 <= h4 && h1 <= e), horner_scheme<1>,
+           std::conditional_t<(h2 <= h4 && h2 <= e), horner_scheme<2>,
+           std::conditional_t<(h4 <= e), horner_scheme<4>, estrin_scheme> > > type;
+};
+
+template <class T, class V, int N>
+constexpr V evaluate_scheme_imp(const T* a, const V& x, int_tag<N>, const auto_scheme*) {
+   return evaluate_scheme_imp(a, x, make_int_tag<N>(),
+                              static_cast<const typename fastest_scheme<N>::type*>(nullptr));
+}
+
+/* Entry point: sizes 0 and 1 are the same for every scheme. */
+template <class Scheme, int N, class T, class V>
+constexpr V evaluate_scheme(const T* a, const V& x, std::true_type) {
+   return evaluate_scheme_imp(a, x, make_int_tag<N>(), static_cast<const Scheme*>(nullptr));
+}
+
+template <class Scheme, int N, class T, class V>
+constexpr V evaluate_scheme(const T* a, const V&, std::false_type) {
+   return N == 0 ? static_cast<V>(0) : static_cast<V>(a[0]);
+}
+
+template <class Scheme, int N, class T, class V>
+constexpr V evaluate_scheme(const T* a, const V& x) {
+   return evaluate_scheme<Scheme, N>(a, x, std::integral_constant<bool, (N > 1)>());
+}
+
+} // namespace detail
+
+#endif // NAM_POLYNOMIAL_SCHEMES_HPP
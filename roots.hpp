@@ -0,0 +1,345 @@
+/*  Roots of polynomials: real roots by Sturm sequences, isolated and refined
+ *  by Newton's method, and all complex roots by the Aberth-Ehrlich method.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_ROOTS_HPP
+#define NAM_ROOTS_HPP
+
+#include <cassert>
+#include <limits> // numeric_limits
+#include <type_traits> // is_integral
+#include "static_poly.hpp"
+#include "chebyshev.hpp" // cos_pi
+#include "derivatives.hpp"
+
+/* Up to N values, e.g. the roots of a static_poly<T, N>, which has at most
+ * N - 1 roots. */
+template <class T, int N>
+struct root_list {
+   T m_roots[N];
+   int m_count;
+
+   constexpr root_list() : m_roots{}, m_count(0) {}
+
+   constexpr int size() const {
+      return m_count;
+   }
+
+   constexpr const T& operator[] (int i) const {
+      return m_roots[i];
+   }
+
+   constexpr void push_back(const T& x) {
+      assert(m_count < N);
+      m_roots[m_count++] = x;
+   }
+};
+
+// an interval (m_lo, m_hi] holding one distinct real root, or a cluster of them
+template <class T>
+struct root_interval {
+   T m_lo, m_hi;
+};
+
+namespace detail {
+   template <class T>
+   constexpr int sign(const T& x) {
+      return x < T(0) ? -1 : T(0) < x ? 1 : 0;
+   }
+
+   // Cauchy's bound: every root z of p has |z| < 1 + max |a_i / a_n|
+   template <class T, int N>
+   constexpr T cauchy_bound(const static_poly<T, N>& p) {
+      const int n = p.degree();
+      T bound = T(0);
+      for (int i = 0; i < n; ++i) {
+         const T r = abs(p[i] / p[n]);
+         if (bound < r)
+            bound = r;
+      }
+      return T(1) + bound;
+   }
+
+   /* In floating point the remainders of a Sturm sequence are as good as the
+    * largest coefficient of the dividend allows; below that, they are rounding
+    * error, and are dropped. */
+   template <class T, int N>
+   constexpr void drop_rounding(static_poly<T, N>& r, const T& scale) {
+      const T tol = T(16 * N) * std::numeric_limits<T>::epsilon() * scale;
+      for (int i = 0; i < N; ++i)
+         if (!(tol < abs(r[i])))
+            r[i] = T(0);
+   }
+}
+
+/* The Sturm sequence of p: p, p', then the negated remainders of each by the
+ * next, down to a constant or, when p has multiple roots, down to the gcd of p
+ * and p'.  The number of distinct real roots in (a, b] is the number of sign
+ * changes along the sequence at a less those at b.  Over a field T: floating
+ * point works, with roots nearer each other than the rounding of the
+ * remainders counted as one. */
+template <class T, int N>
+struct sturm_sequence {
+   static_poly<T, N> m_polys[N];
+   int m_count;
+
+   constexpr explicit sturm_sequence(const static_poly<T, N>& p) : m_polys{p}, m_count(1) {
+      static_assert(!std::is_integral<T>::value, "Sturm sequences need a field");
+      assert(p);
+      if (p.degree() < 1)
+         return;
+      m_polys[m_count++] = static_poly<T, N>(derivative(p));
+      while (m_polys[m_count - 1].degree() > 0) {
+         const static_poly<T, N>& u = m_polys[m_count - 2];
+         const static_poly<T, N>& v = m_polys[m_count - 1];
+         static_poly<T, N> r(u), q;
+         T scale = T(0);
+         for (int i = 0; i < N; ++i)
+            if (scale < detail::abs(u[i]))
+               scale = detail::abs(u[i]);
+         detail::long_division(q.m_data, r.m_data, v.m_data, u.degree(), v.degree());
+         r = -r;
+         detail::drop_rounding(r, scale);
+         if (!r)
+            break;
+         m_polys[m_count++] = r;
+      }
+   }
+
+   constexpr int sign_changes(const T& x) const {
+      int changes = 0, last = 0;
+      for (int k = 0; k < m_count; ++k) {
+         const int s = detail::sign(m_polys[k](x));
+         if (s && s != last) {
+            changes += last != 0;
+            last = s;
+         }
+      }
+      return changes;
+   }
+
+   // at -infinity, or at +infinity
+   constexpr int sign_changes_at_infinity(bool negative) const {
+      int changes = 0, last = 0;
+      for (int k = 0; k < m_count; ++k) {
+         const int n = m_polys[k].degree();
+         const int s = detail::sign(m_polys[k][n]) * (negative && n % 2 ? -1 : 1);
+         changes += last && s != last;
+         last = s;
+      }
+      return changes;
+   }
+
+   // the number of distinct real roots in (a, b]
+   constexpr int count_roots(const T& a, const T& b) const {
+      return sign_changes(a) - sign_changes(b);
+   }
+
+   // the number of distinct real roots
+   constexpr int count_roots() const {
+      return sign_changes_at_infinity(true) - sign_changes_at_infinity(false);
+   }
+
+   // p over the gcd of p and p': the same roots, all simple
+   constexpr static_poly<T, N> squarefree() const {
+      const static_poly<T, N>& g = m_polys[m_count - 1];
+      const int n = g.degree();
+      if (n < 1)
+         return m_polys[0];
+      static_poly<T, N> u(m_polys[0]), q;
+      detail::long_division(q.m_data, u.m_data, g.m_data, m_polys[0].degree(), n);
+      return q;
+   }
+};
+
+/* Intervals (lo, hi] holding one distinct real root of p each, in increasing
+ * order, found by bisecting (-B, B], B the Cauchy bound, with the Sturm
+ * sequence counting the roots in each half.  Roots too close to be told apart
+ * in T share an interval that can't be split further. */
+template <class T, int N>
+constexpr root_list<root_interval<T>, N> isolate_real_roots(const sturm_sequence<T, N>& s) {
+   root_list<root_interval<T>, N> out;
+   const T bound = detail::cauchy_bound(s.m_polys[0]);
+   // the work list, in order: intervals with their root counts
+   root_interval<T> work[N] {};
+   int counts[N] {}, size = 0;
+   if (const int c = s.count_roots(-bound, bound)) {
+      work[0] = {-bound, bound};
+      counts[0] = c;
+      size = 1;
+   }
+   for (int i = 0; i < size;) {
+      const T lo = work[i].m_lo, hi = work[i].m_hi, mid = (lo + hi) / T(2);
+      if (counts[i] < 2 || !(lo < mid && mid < hi)) {
+         ++i;
+         continue;
+      }
+      const int left = s.count_roots(lo, mid), right = counts[i] - left;
+      if (left > 0 && right > 0) {
+         for (int j = size; j > i + 1; --j) {
+            work[j] = work[j - 1];
+            counts[j] = counts[j - 1];
+         }
+         ++size;
+         work[i + 1] = {mid, hi};
+         counts[i + 1] = right;
+         work[i] = {lo, mid};
+         counts[i] = left;
+      } else if (left > 0) {
+         work[i] = {lo, mid};
+      } else {
+         work[i] = {mid, hi};
+      }
+   }
+   for (int i = 0; i < size; ++i)
+      out.push_back(work[i]);
+   return out;
+}
+
+template <class T, int N>
+constexpr root_list<root_interval<T>, N> isolate_real_roots(const static_poly<T, N>& p) {
+   return isolate_real_roots(sturm_sequence<T, N>(p));
+}
+
+/* The root of q in the interval (lo, hi], where q changes sign once, by
+ * Newton's method kept inside a shrinking bracket: where a step would leave
+ * it, or fails to halve it, it bisects instead.  q should have simple roots,
+ * like sturm_sequence::squarefree(). */
+template <class T, int N>
+constexpr T refine_root(const static_poly<T, N>& q, root_interval<T> r, int iterations = 100) {
+   if (q(r.m_hi) == T(0))
+      return r.m_hi;
+   // the sign of q just right of lo; q'(lo) if lo is the root before
+   const derivative_values<T, 1> at_lo = evaluate_with_derivatives<1>(q, r.m_lo);
+   const int lo_sign = at_lo[0] == T(0) ? detail::sign(at_lo[1]) : detail::sign(at_lo[0]);
+   T x = (r.m_lo + r.m_hi) / T(2), width = r.m_hi - r.m_lo;
+   for (int it = 0; it < iterations; ++it) {
+      const derivative_values<T, 1> d = evaluate_with_derivatives<1>(q, x);
+      const T v = d[0], dq = d[1];
+      if (v == T(0))
+         return x;
+      if (detail::sign(v) == lo_sign)
+         r.m_lo = x;
+      else
+         r.m_hi = x;
+      T next = dq == T(0) ? r.m_lo : x - v / dq;
+      if (!(r.m_lo < next && next < r.m_hi) || !(detail::abs(next - x) < width / T(2)))
+         next = (r.m_lo + r.m_hi) / T(2);
+      width = detail::abs(next - x);
+      if (next == x || !(std::numeric_limits<T>::epsilon() * detail::abs(x) < width))
+         return next;
+      x = next;
+   }
+   return x;
+}
+
+/* The distinct real roots of p in increasing order, isolated by its Sturm
+ * sequence and refined by refine_root, at compile time if need be:
+ *    constexpr static_poly<double, 4> p {6, -5, -2, 1}; // (x+2)(x-1)(x-3)
+ *    constexpr auto roots = real_roots(p); // -2, 1, 3
+ * A cluster of roots closer than T resolves comes out once. */
+template <class T, int N>
+constexpr root_list<T, N> real_roots(const static_poly<T, N>& p) {
+   const sturm_sequence<T, N> s(p);
+   const root_list<root_interval<T>, N> intervals = isolate_real_roots(s);
+   const static_poly<T, N> q = s.squarefree();
+   root_list<T, N> out;
+   for (int i = 0; i < intervals.size(); ++i)
+      out.push_back(refine_root(q, intervals[i]));
+   return out;
+}
+
+namespace detail {
+   // |z|², for complex types with real() and imag()
+   template <class C>
+   constexpr auto norm(const C& z) -> decltype(z.real()) {
+      return z.real() * z.real() + z.imag() * z.imag();
+   }
+
+   // y^(1/n), y > 0, by Newton's method from a power of two above
+   template <class R>
+   constexpr R nth_root(const R& y, int n) {
+      R t = R(1);
+      while (integer_power(t, n) < y)
+         t *= R(2);
+      while (y <= integer_power(t / R(2), n))
+         t /= R(2);
+      for (int it = 0; it < 100; ++it) {
+         const R next = t - (integer_power(t, n) - y) / (R(n) * integer_power(t, n - 1));
+         if (!(next < t))
+            break;
+         t = next;
+      }
+      return t;
+   }
+}
+
+/* All n roots of p of degree n, in the complex type C (smath::complex, or any
+ * with the arithmetic operators, real(), imag() and construction from real
+ * and imaginary parts, constexpr for constant expressions), by the Aberth-
+ * Ehrlich method: simultaneous Newton steps, each corrected for the pull of
+ * the other approximations,
+ *    z_k -= w_k / (1 - w_k Σ_{j≠k} 1 / (z_k - z_j)),   w_k = p(z_k) / p'(z_k),
+ * from n points spread on the circle of the geometric mean of the roots'
+ * moduli.  Convergence is cubic for simple roots, linear for multiple ones;
+ * it stops when no step moves a root by more than a few units in the last
+ * place, or after `iterations` sweeps.  p may have real or C coefficients:
+ *    constexpr auto z = complex_roots<smath::complex<double> >(p); */
+template <class C, class T, int N>
+constexpr root_list<C, N> complex_roots(const static_poly<T, N>& p, int iterations = 100) {
+   typedef decltype(C().real()) R;
+   assert(p);
+   root_list<C, N> out;
+   // zero roots come out exactly
+   int low = 0;
+   while (p[low] == T(0)) {
+      out.push_back(C(R(0), R(0)));
+      ++low;
+   }
+   static_poly<C, N> q;
+   const int n = p.degree() - low;
+   for (int i = 0; i <= n; ++i)
+      q[i] = C(p[i + low]);
+   if (n < 1)
+      return out;
+
+   const R radius = detail::nth_root(detail::norm(q[0] / q[n]), 2 * n);
+   C z[N] {};
+   for (int k = 0; k < n; ++k) {
+      // angles 2πk/n, turned off the real axis, which is symmetric for real p
+      const R r = R(2 * k) / R(n) + R(0.25) / R(n);
+      const R t = r > R(1) ? R(2) - r : r;
+      const R c = detail::cos_pi(t), s = detail::cos_pi(detail::abs(t - R(0.5)));
+      z[k] = C(radius * c, r > R(1) ? -radius * s : radius * s);
+   }
+   const R tol = R(16) * std::numeric_limits<R>::epsilon();
+   for (int it = 0; it < iterations; ++it) {
+      bool moved = false;
+      for (int k = 0; k < n; ++k) {
+         C v = q[n], dv = C(R(0), R(0));
+         for (int i = n; i > 0; --i) {
+            dv = dv * z[k] + v;
+            v = v * z[k] + q[i - 1];
+         }
+         if (detail::norm(v) == R(0))
+            continue;
+         const C w = v / dv;
+         C pull = C(R(0), R(0));
+         for (int j = 0; j < n; ++j)
+            if (j != k)
+               pull = pull + C(R(1), R(0)) / (z[k] - z[j]);
+         const C step = w / (C(R(1), R(0)) - w * pull);
+         z[k] = z[k] - step;
+         moved = moved || tol * tol * detail::norm(z[k]) < detail::norm(step);
+      }
+      if (!moved)
+         break;
+   }
+   for (int k = 0; k < n; ++k)
+      out.push_back(z[k]);
+   return out;
+}
+
+#endif // NAM_ROOTS_HPP
@@ -0,0 +1,425 @@
+/*  Polynomials of high degree and few terms, as (exponent, coefficient) pairs.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_SPARSE_POLY_HPP
+#define NAM_SPARSE_POLY_HPP
+
+#include <cassert>
+#include <algorithm> // min, max
+#include <type_traits> // is_integral
+#include <utility> // pair
+#include <initializer_list>
+#include "static_poly.hpp"
+
+template <class T>
+struct sparse_term {
+   int m_exp;
+   T m_coef;
+};
+
+/* A polynomial of degree less than N with at most K nonzero terms, such as
+ * x^105 - 1, which is sparse_poly<int, 106, 2>{{105, 1}, {0, -1}}.  The terms
+ * are kept in order of increasing exponent, without zero coefficients, so the
+ * work of each operation goes with the number of terms rather than with N.
+ * N plays the part it does for static_poly: it fixes the sizes of results,
+ * and a divisor should have degree N - 1. */
+template <class T, int N, int K>
+struct sparse_poly {
+   sparse_term<T> m_terms[K];
+   int m_count;
+
+   // typedefs:
+   typedef T value_type;
+   typedef int size_type;
+
+   // construct:
+   constexpr sparse_poly() : m_terms{}, m_count(0) {}
+
+   // terms in any order; those with the same exponent are added up
+   constexpr sparse_poly(std::initializer_list<sparse_term<T> > l) : sparse_poly() {
+      for (const sparse_term<T>& t : l)
+         add(t.m_exp, t.m_coef);
+   }
+
+   template <int N1, int K1>
+   explicit constexpr sparse_poly(const sparse_poly<T, N1, K1>& p) : sparse_poly() {
+      assert(p.m_count <= K && p.degree() < N);
+      for (int t = 0; t < p.m_count; ++t)
+         m_terms[t] = p.m_terms[t];
+      m_count = p.m_count;
+   }
+
+   template <class U, int N1>
+   explicit constexpr sparse_poly(const static_poly<U, N1>& p) : sparse_poly() {
+      for (int i = 0; i < N1; ++i)
+         add(i, T(p[i]));
+   }
+
+   // access:
+   constexpr size_type size() const {
+      return N;
+   }
+
+   constexpr size_type terms() const {
+      return m_count;
+   }
+
+   constexpr size_type degree() const {
+      return m_count ? m_terms[m_count - 1].m_exp : -1;
+   }
+
+   constexpr const sparse_term<T>& term(size_type t) const {
+      return m_terms[t];
+   }
+
+   // the coefficient of x^i, by binary search
+   constexpr T operator[] (size_type i) const {
+      int lo = 0, hi = m_count;
+      while (lo < hi) {
+         const int mid = (lo + hi) / 2;
+         if (m_terms[mid].m_exp < i)
+            lo = mid + 1;
+         else
+            hi = mid;
+      }
+      return lo < m_count && m_terms[lo].m_exp == i ? m_terms[lo].m_coef : T(0);
+   }
+
+   // adds c x^e
+   constexpr void add(int e, const T& c) {
+      if (c == T(0))
+         return;
+      assert(e >= 0 && e < N);
+      int t = m_count;
+      while (t > 0 && m_terms[t - 1].m_exp > e)
+         --t;
+      if (t > 0 && m_terms[t - 1].m_exp == e) {
+         m_terms[t - 1].m_coef += c;
+         if (m_terms[t - 1].m_coef == T(0))
+            erase(t - 1);
+         return;
+      }
+      assert(m_count < K);
+      for (int j = m_count; j > t; --j)
+         m_terms[j] = m_terms[j - 1];
+      m_terms[t] = {e, c};
+      ++m_count;
+   }
+
+   constexpr void erase(size_type t) {
+      --m_count;
+      for (; t < m_count; ++t)
+         m_terms[t] = m_terms[t + 1];
+      m_terms[m_count] = {};
+   }
+
+   /* Horner's rule over the terms, with the powers of z for the gaps between
+    * exponents by binary powering */
+   constexpr T operator() (T z) const {
+      if (!m_count)
+         return T(0);
+      T sum = m_terms[m_count - 1].m_coef;
+      for (int t = m_count - 1; t > 0; --t) {
+         sum *= detail::integer_power(z, m_terms[t].m_exp - m_terms[t - 1].m_exp);
+         sum += m_terms[t - 1].m_coef;
+      }
+      if (m_terms[0].m_exp)
+         sum *= detail::integer_power(z, m_terms[0].m_exp);
+      return sum;
+   }
+
+   constexpr static_poly<T, N> to_static() const {
+      static_poly<T, N> p;
+      for (int t = 0; t < m_count; ++t)
+         p[m_terms[t].m_exp] = m_terms[t].m_coef;
+      return p;
+   }
+
+   // operators:
+   template <class U>
+   constexpr sparse_poly& operator +=(const U& value) {
+      add(0, T(value));
+      return *this;
+   }
+
+   template <class U>
+   constexpr sparse_poly& operator -=(const U& value) {
+      add(0, T(-value));
+      return *this;
+   }
+
+   template <class U>
+   constexpr sparse_poly& operator *=(const U& value) {
+      for (int t = 0; t < m_count; ++t)
+         m_terms[t].m_coef *= value;
+      drop_zeros();
+      return *this;
+   }
+
+   template <class U>
+   constexpr sparse_poly& operator /=(const U& value) {
+      for (int t = 0; t < m_count; ++t)
+         m_terms[t].m_coef /= value;
+      drop_zeros(); // integer division can make zeros
+      return *this;
+   }
+
+   constexpr void drop_zeros() {
+      int kept = 0;
+      for (int t = 0; t < m_count; ++t)
+         if (m_terms[t].m_coef != T(0))
+            m_terms[kept++] = m_terms[t];
+      for (int t = kept; t < m_count; ++t)
+         m_terms[t] = {};
+      m_count = kept;
+   }
+
+   explicit constexpr operator bool() const {
+      return m_count > 0;
+   }
+};
+
+namespace detail {
+   // merges the terms of a and (if subtract, minus) b into out, which is empty
+   template <bool subtract, class T, int N1, int K1, int N2, int K2, int N, int K>
+   constexpr void merge_terms(const sparse_poly<T, N1, K1>& a, const sparse_poly<T, N2, K2>& b,
+                              sparse_poly<T, N, K>& out) {
+      int i = 0, j = 0;
+      while (i < a.m_count || j < b.m_count) {
+         sparse_term<T> t{};
+         if (j == b.m_count || (i < a.m_count && a.m_terms[i].m_exp < b.m_terms[j].m_exp))
+            t = a.m_terms[i++];
+         else if (i == a.m_count || b.m_terms[j].m_exp < a.m_terms[i].m_exp) {
+            t = b.m_terms[j++];
+            if (subtract)
+               t.m_coef = -t.m_coef;
+         } else {
+            t = a.m_terms[i++];
+            t.m_coef = subtract ? t.m_coef - b.m_terms[j++].m_coef : t.m_coef + b.m_terms[j++].m_coef;
+            if (t.m_coef == T(0))
+               continue;
+         }
+         out.m_terms[out.m_count++] = t;
+      }
+   }
+
+   // whether v can be divided by term by term: over a field, or by ±1
+   template <class T>
+   constexpr bool sparse_divisible(const T& lc) {
+      return !std::is_integral<T>::value || use_monic_division(lc, std::true_type());
+   }
+
+   /* Long division of u, of degree m, by the sparse v, of degree n <= m, as
+    * long_division does: the quotient goes to q[0 .. m-n] and the remainder
+    * is left in u[0 .. n-1].  Each quotient term costs one pass over the
+    * terms of v rather than over all n + 1 coefficients. */
+   template <class T, int N, int K>
+   constexpr void sparse_division(T* q, T* u, const sparse_poly<T, N, K>& v, int m, int n) {
+      const int top = v.m_count - 1;
+      const T lc = v.m_terms[top].m_coef;
+      for (int k = m - n; k >= 0; --k) {
+         // over an integral type lc is ±1, its own inverse
+         q[k] = std::is_integral<T>::value ? u[n + k] * lc : u[n + k] / lc;
+         if (q[k] == T(0))
+            continue;
+         for (int t = 0; t < top; ++t)
+            u[v.m_terms[t].m_exp + k] -= q[k] * v.m_terms[t].m_coef;
+      }
+      for (int j = n; j <= m; ++j)
+         u[j] = T(0);
+   }
+}
+
+// a constant can add a term
+template <class T, int N, int K, class U>
+constexpr sparse_poly<T, N, K + 1> operator + (const sparse_poly<T, N, K>& a, const U& b) {
+   return sparse_poly<T, N, K + 1>(a) += b;
+}
+
+template <class T, int N, int K, class U>
+constexpr sparse_poly<T, N, K + 1> operator - (const sparse_poly<T, N, K>& a, const U& b) {
+   return sparse_poly<T, N, K + 1>(a) -= b;
+}
+
+template <class U, class T, int N, int K>
+constexpr sparse_poly<T, N, K + 1> operator + (const U& a, const sparse_poly<T, N, K>& b) {
+   return b + a;
+}
+
+template <class U, class T, int N, int K>
+constexpr sparse_poly<T, N, K + 1> operator - (const U& a, const sparse_poly<T, N, K>& b) {
+   return -b + a;
+}
+
+template <class T, int N, int K, class U>
+constexpr sparse_poly<T, N, K> operator * (sparse_poly<T, N, K> a, const U& b) {
+   return a *= b;
+}
+
+template <class U, class T, int N, int K>
+constexpr sparse_poly<T, N, K> operator * (const U& a, sparse_poly<T, N, K> b) {
+   return b *= a;
+}
+
+template <class T, int N, int K, class U>
+constexpr sparse_poly<T, N, K> operator / (sparse_poly<T, N, K> a, const U& b) {
+   return a /= b;
+}
+
+// Unary minus (negate).
+template <class T, int N, int K>
+constexpr sparse_poly<T, N, K> operator - (sparse_poly<T, N, K> a) {
+   for (int t = 0; t < a.m_count; ++t)
+      a.m_terms[t].m_coef *= -1;
+   return a;
+}
+
+template <class T, int N1, int K1, int N2, int K2>
+constexpr sparse_poly<T, std::max(N1, N2), K1 + K2> operator + (const sparse_poly<T, N1, K1>& a, const sparse_poly<T, N2, K2>& b) {
+   sparse_poly<T, std::max(N1, N2), K1 + K2> sum;
+   detail::merge_terms<false>(a, b, sum);
+   return sum;
+}
+
+template <class T, int N1, int K1, int N2, int K2>
+constexpr sparse_poly<T, std::max(N1, N2), K1 + K2> operator - (const sparse_poly<T, N1, K1>& a, const sparse_poly<T, N2, K2>& b) {
+   sparse_poly<T, std::max(N1, N2), K1 + K2> diff;
+   detail::merge_terms<true>(a, b, diff);
+   return diff;
+}
+
+template <class T, int N1, int K1, int N2, int K2>
+constexpr sparse_poly<T, N1 + N2 - 1, K1 * K2> operator * (const sparse_poly<T, N1, K1>& a, const sparse_poly<T, N2, K2>& b) {
+   sparse_poly<T, N1 + N2 - 1, K1 * K2> prod;
+   for (int i = 0; i < a.m_count; ++i)
+      for (int j = 0; j < b.m_count; ++j)
+         prod.add(a.m_terms[i].m_exp + b.m_terms[j].m_exp, a.m_terms[i].m_coef * b.m_terms[j].m_coef);
+   return prod;
+}
+
+/* With static_poly: the results are dense */
+
+template <class T, int N1, int K, int N2>
+constexpr static_poly<T, std::max(N1, N2)> operator + (const sparse_poly<T, N1, K>& a, const static_poly<T, N2>& b) {
+   static_poly<T, std::max(N1, N2)> sum(b);
+   for (int t = 0; t < a.m_count; ++t)
+      sum[a.m_terms[t].m_exp] += a.m_terms[t].m_coef;
+   return sum;
+}
+
+template <class T, int N1, int N2, int K>
+constexpr static_poly<T, std::max(N1, N2)> operator + (const static_poly<T, N1>& a, const sparse_poly<T, N2, K>& b) {
+   return b + a;
+}
+
+template <class T, int N1, int K, int N2>
+constexpr static_poly<T, std::max(N1, N2)> operator - (const sparse_poly<T, N1, K>& a, const static_poly<T, N2>& b) {
+   return a + -b;
+}
+
+template <class T, int N1, int N2, int K>
+constexpr static_poly<T, std::max(N1, N2)> operator - (const static_poly<T, N1>& a, const sparse_poly<T, N2, K>& b) {
+   return -b + a;
+}
+
+// one pass over b for each term of a
+template <class T, int N1, int K, int N2>
+constexpr static_poly<T, N1 + N2 - 1> operator * (const sparse_poly<T, N1, K>& a, const static_poly<T, N2>& b) {
+   static_poly<T, N1 + N2 - 1> prod;
+   const int nb = b.degree() + 1;
+   for (int t = 0; t < a.m_count; ++t) {
+      const int e = a.m_terms[t].m_exp;
+      for (int j = 0; j < nb; ++j)
+         prod[e + j] += a.m_terms[t].m_coef * b[j];
+   }
+   return prod;
+}
+
+template <class T, int N1, int N2, int K>
+constexpr static_poly<T, N1 + N2 - 1> operator * (const static_poly<T, N1>& a, const sparse_poly<T, N2, K>& b) {
+   return b * a;
+}
+
+/* Calculates a / b and a % b as quotient_remainder on static_polys does, by
+ * sparse_division when b is over a field or has a leading coefficient of ±1
+ * (as x^n - 1 has), otherwise by pseudo-division of the dense b.
+ * This function is not defined for division by zero: user beware.
+ */
+template <typename T, int N1, int N2, int K>
+std::pair< static_poly<T, std::max(N1 - N2 + 1, 1)>, static_poly<T, std::min(N1, N2)> >
+constexpr quotient_remainder(const static_poly<T, N1>& dividend, const sparse_poly<T, N2, K>& divisor) {
+   assert(divisor);
+   constexpr int sz = std::max(N1 - N2 + 1, 1);
+   const int m = dividend.degree(), n = divisor.degree();
+   if (m < n)
+      return std::make_pair(static_poly<T, sz>(), static_poly<T, std::min(N1, N2)>(dividend));
+   if (!detail::sparse_divisible(divisor.m_terms[divisor.m_count - 1].m_coef))
+      return detail::division(dividend, divisor.to_static(), m, n);
+   static_poly<T, sz> q;
+   static_poly<T, N1> r(dividend);
+   assert(m - n < q.size()); // the quotient fits when the divisor has no headroom
+   detail::sparse_division(q.m_data, r.m_data, divisor, m, n);
+   return std::make_pair(q, static_poly<T, std::min(N1, N2)>(r));
+}
+
+template <typename T, int N1, int K1, int N2, int K2>
+std::pair< static_poly<T, std::max(N1 - N2 + 1, 1)>, static_poly<T, std::min(N1, N2)> >
+constexpr quotient_remainder(const sparse_poly<T, N1, K1>& dividend, const sparse_poly<T, N2, K2>& divisor) {
+   return quotient_remainder(dividend.to_static(), divisor);
+}
+
+// a sparse dividend is divided densely
+template <typename T, int N1, int K, int N2>
+std::pair< static_poly<T, std::max(N1 - N2 + 1, 1)>, static_poly<T, std::min(N1, N2)> >
+constexpr quotient_remainder(const sparse_poly<T, N1, K>& dividend, const static_poly<T, N2>& divisor) {
+   return quotient_remainder(dividend.to_static(), divisor);
+}
+
+template <class T, int N1, int N2, int K>
+constexpr static_poly<T, std::max(N1 - N2 + 1, 1)> operator / (const static_poly<T, N1>& a, const sparse_poly<T, N2, K>& b) {
+   return quotient_remainder(a, b).first;
+}
+
+template <class T, int N1, int N2, int K>
+constexpr static_poly<T, std::min(N1, N2)> operator % (const static_poly<T, N1>& a, const sparse_poly<T, N2, K>& b) {
+   return quotient_remainder(a, b).second;
+}
+
+template <class T, int N1, int K, int N2>
+constexpr static_poly<T, std::max(N1 - N2 + 1, 1)> operator / (const sparse_poly<T, N1, K>& a, const static_poly<T, N2>& b) {
+   return quotient_remainder(a, b).first;
+}
+
+template <class T, int N1, int K, int N2>
+constexpr static_poly<T, std::min(N1, N2)> operator % (const sparse_poly<T, N1, K>& a, const static_poly<T, N2>& b) {
+   return quotient_remainder(a, b).second;
+}
+
+template <class T, int N1, int K1, int N2, int K2>
+constexpr static_poly<T, std::max(N1 - N2 + 1, 1)> operator / (const sparse_poly<T, N1, K1>& a, const sparse_poly<T, N2, K2>& b) {
+   return quotient_remainder(a, b).first;
+}
+
+template <class T, int N1, int K1, int N2, int K2>
+constexpr static_poly<T, std::min(N1, N2)> operator % (const sparse_poly<T, N1, K1>& a, const sparse_poly<T, N2, K2>& b) {
+   return quotient_remainder(a, b).second;
+}
+
+template <class T, int N1, int K1, int N2, int K2>
+constexpr bool operator == (const sparse_poly<T, N1, K1>& a, const sparse_poly<T, N2, K2>& b) {
+   if (a.m_count != b.m_count)
+      return false;
+   for (int t = 0; t < a.m_count; ++t)
+      if (a.m_terms[t].m_exp != b.m_terms[t].m_exp || a.m_terms[t].m_coef != b.m_terms[t].m_coef)
+         return false;
+   return true;
+}
+
+template <class T, int N1, int K1, int N2, int K2>
+constexpr bool operator != (const sparse_poly<T, N1, K1>& a, const sparse_poly<T, N2, K2>& b) {
+   return !(a == b);
+}
+
+#endif // NAM_SPARSE_POLY_HPP
@@ -17,13 +17,30 @@
 #include <type_traits> // enable_if, is_integral
 #include <utility> // pair
 #include <initializer_list>
+#include <limits> // numeric_limits
 #include "evaluate.hpp"
+#include "multiply.hpp"
+#include "divide.hpp"
 
 template <typename T, int N>
 struct static_poly;
 
 namespace detail {
 
+// the degree of a[0 .. top], or -1 if those are all zero
+template <class T>
+constexpr int degree_from(const T* a, int top) {
+   while (top >= 0 && a[top] == T{0})
+      --top;
+   return top;
+}
+
+// |x|, where std::abs isn't constexpr
+template <class T>
+constexpr T abs(const T& x) {
+   return x < T(0) ? -x : x;
+}
+
 /**
 * Knuth, The Art of Computer Programming: Volume 2, Third edition, 1998
 * Chapter 4.6.1, Algorithm D: Division of polynomials over a field.
@@ -33,9 +50,9 @@ namespace detail {
 * Template-parameter T actually must be a field but we don't currently have that
 * subtlety of distinction.
 */
-template <typename T, int N1, int N2, int N3>
+template <typename T>
 std::enable_if_t<!std::is_integral<T>::value> /*void*/
-constexpr division_impl(static_poly<T, N3> &q, static_poly<T, N1> &u, const static_poly<T, N2>& v, int n, int k) {
+constexpr division_impl(T* q, T* u, const T* v, int n, int k) {
     q[k] = u[n + k] / v[n];
     for (int j = n + k; j > k;) {
         j--;
@@ -72,9 +89,9 @@ constexpr T integer_power(T t, int n) {
 * Template-parameter T actually must be a unique factorization domain but we
 * don't currently have that subtlety of distinction.
 */
-template <typename T, int N1, int N2, int N3>
+template <typename T>
 std::enable_if_t<std::is_integral<T>::value> /*void*/
-constexpr division_impl(static_poly<T, N3> &q, static_poly<T, N1> &u, const static_poly<T, N2>& v, int n, int k) {
+constexpr division_impl(T* q, T* u, const T* v, int n, int k) {
    q[k] = u[n + k] * integer_power(v[n], k);
    for (int j = n + k; j > 0;) {
       j--;
@@ -83,27 +100,118 @@ constexpr division_impl(static_poly<T, N3> &q, static_poly<T, N1> &u, const stat
 }
 
 
+/* Exact long division over an integral type, for a leading coefficient v[n]
+ * of 1 or -1: it's its own inverse, so Algorithm D applies as over a field,
+ * without the rescaling of Algorithm R and the growth that comes with it.
+ * The quotient and remainder are then the true ones, where pseudo-division by
+ * -1 would give them times (-1)^(m-n+1). */
+template <typename T>
+constexpr void monic_division_impl(T* q, T* u, const T* v, int n, int k) {
+   q[k] = u[n + k] * v[n];
+   for (int j = n + k; j > k;) {
+      j--;
+      u[j] -= q[k] * v[j - k];
+   }
+}
+
+/* Whether long division goes through monic_division_impl.
+ * Define NAM_STATIC_POLY_MONIC_DIVISION to 0 to always pseudo-divide. */
+#ifndef NAM_STATIC_POLY_MONIC_DIVISION
+#  define NAM_STATIC_POLY_MONIC_DIVISION 1
+#endif
+
+template <class T>
+constexpr bool use_monic_division(const T&, std::false_type) {
+   return false; // division_impl is already exact
+}
+
+template <class T>
+constexpr bool use_monic_division(const T& lc, std::true_type /* integral */) {
+   return NAM_STATIC_POLY_MONIC_DIVISION
+       && (lc == T(1) || (std::is_signed<T>::value && lc == T(-1)));
+}
+
+
+/* Whether to divide by Newton iteration (divide.hpp), for a quotient of nq
+ * terms and a divisor of nv terms with leading coefficient lc.  That needs lc
+ * to be invertible: over an integral type, it has to be 1, or -1 as long as
+ * long division is exact for it too (use_monic_division).
+ * Other types have to be exact (by std::numeric_limits): in floating point the
+ * coefficients of the power series 1/rev(v) grow geometrically when rev(v) has
+ * a root inside the unit circle, and the quotient drowns in the cancellation
+ * or overflows. */
+template <class T>
+constexpr bool use_newton_division(const T&, int nq, int nv, std::false_type) {
+   return std::numeric_limits<T>::is_exact && std::min(nq, nv) >= newton_field_division_threshold;
+}
+
+template <class T>
+constexpr bool use_newton_division(const T& lc, int nq, int nv, std::true_type /* integral */) {
+   return std::min(nq, nv) >= newton_division_threshold
+       && (lc == T(1) || use_monic_division(lc, std::true_type()));
+}
+
+/* Long division of u, of degree m, by v, of degree n <= m: the quotient goes
+ * to q[0 .. m-n] and the remainder is left in u[0 .. n-1], with u[n .. m]
+ * zeroed.  By monic_division_impl for integral divisors with leading
+ * coefficient ±1, otherwise division_impl. */
+template <typename T>
+constexpr void long_division(T* q, T* u, const T* v, int m, int n) {
+   int k = m - n;
+   if (use_monic_division(v[n], std::is_integral<T>())) {
+      do monic_division_impl(q, u, v, n, k);
+      while (k--);
+   } else {
+      do division_impl(q, u, v, n, k);
+      while (k--); // stops when k was already 0
+   }
+   for (int j = n; j <= m; ++j)
+      u[j] = T(0); // eliminated; division_impl doesn't bother to store the zeros
+}
+
+template <typename T, int N1, int N2>
+std::pair< static_poly<T, std::max(N1 - N2 + 1, 1)>, static_poly<T, std::min(N1, N2)> >
+constexpr newton_division(const static_poly<T, N1>& u, const static_poly<T, N2>& v, int m, int n) {
+   typedef typename newton_ring<T>::type R;
+   R ur[N1] {}, vr[N2] {}, qr[std::max(N1 - N2 + 1, 1)] {}, rr[std::min(N1, N2)] {};
+   R scratch[newton_division_scratch(N1)] {};
+   for (int i = 0; i <= m; ++i)
+      ur[i] = static_cast<R>(u[i]);
+   for (int i = 0; i <= n; ++i)
+      vr[i] = static_cast<R>(v[i]);
+   newton_divide(ur, m + 1, vr, n + 1, qr, rr, scratch);
+   static_poly<T, std::max(N1 - N2 + 1, 1)> q;
+   static_poly<T, std::min(N1, N2)> r;
+   for (int i = 0; i < q.size(); ++i)
+      q[i] = static_cast<T>(qr[i]);
+   for (int i = 0; i < r.size(); ++i)
+      r[i] = static_cast<T>(rr[i]);
+   return std::make_pair(q, r);
+}
+
 /**
  * Knuth, The Art of Computer Programming: Volume 2, Third edition, 1998
  * Chapter 4.6.1, Algorithm D and R: Main loop.
+ * Large divisions by an invertible leading coefficient go to newton_division;
+ * integral divisions by a leading coefficient of ±1 to monic_division_impl.
  *
- * @param   u   Dividend.
- * @param   v   Divisor.
+ * @param   u   Dividend, of degree m.
+ * @param   v   Divisor, of degree n <= m.
  */
 template <typename T, int N1, int N2>
 std::pair< static_poly<T, std::max(N1 - N2 + 1, 1)>, static_poly<T, std::min(N1, N2)> >
-constexpr division(static_poly<T, N1> u, const static_poly<T, N2>& v) {
+constexpr division(static_poly<T, N1> u, const static_poly<T, N2>& v, int m, int n) {
    assert(v.size() <= u.size());
-   assert(v);
-   assert(u);
+   assert(n >= 0 && n <= m);
 
-   const int m = u.degree(), n = v.degree();
-   int k = m - n;
+   const int k = m - n;
    static_poly<T, std::max(N1 - N2 + 1, 1)> q;
+   assert(k < q.size()); // the quotient fits when v has no headroom
 
-   do division_impl(q, u, v, n, k);
-   while (k--); // stops when k was already 0
+   if (use_newton_division(v[n], k + 1, n + 1, std::is_integral<T>()))
+      return newton_division(u, v, m, n);
 
+   long_division(q.m_data, u.m_data, v.m_data, m, n);
    return std::make_pair(q, static_poly<T, std::min(N1, N2)>(u));
 }
 
@@ -118,9 +226,10 @@ std::pair< static_poly<T, std::max(N1 - N2 + 1, 1)>, static_poly<T, std::min(N1,
 constexpr quotient_remainder(const static_poly<T, N1>& dividend, const static_poly<T, N2>& divisor) {
    assert(divisor);
    constexpr int sz = std::max(N1 - N2 + 1, 1);
-   if (dividend.degree() < divisor.degree())
+   const int m = dividend.degree(), n = divisor.degree();
+   if (m < n)
       return std::make_pair(static_poly<T, sz>(), static_poly<T, std::min(N1, N2)>(dividend));
-   return detail::division(dividend, divisor);
+   return detail::division(dividend, divisor, m, n);
 }
 
 
@@ -163,11 +272,10 @@ struct static_poly {
       return N;
    }
 
+   // scans down from the top; tracked_poly (tracked_poly.hpp) keeps it instead
    constexpr size_type degree() const {
-      for (int i = N-1; i >= 0; --i)
-         if (m_data[i] != T{0})
-            return i;
-      return -1; // zero polynomial: should really be -∞, or undefined.
+      // -1 for the zero polynomial: should really be -∞, or undefined.
+      return detail::degree_from(m_data, N - 1);
    }
 
    constexpr T& operator[] (size_type i) {
@@ -181,6 +289,12 @@ struct static_poly {
    constexpr T operator() (T z) const {
       return evaluate_polynomial(m_data, z);
    }
+
+   // evaluate with a particular scheme from polynomial_schemes.hpp
+   template <class Scheme = auto_scheme>
+   constexpr T evaluate(T z) const {
+      return evaluate_polynomial<Scheme>(m_data, z);
+   }
    
    constexpr const std::pair<const T*, const T*> data() const {
       // return a pair of iterators, suitable for use with Boost.Range
@@ -299,15 +413,73 @@ constexpr static_poly<T, std::max(N1, N2)> operator - (const static_poly<T, N1>&
    return diff;
 }
 
+namespace detail {
+   /* Multiplies by number theoretic transform or Karatsuba into out if T allows
+    * it and both factors are long enough; returns whether it did.  Cap bounds
+    * the lengths na and nb. */
+   template <int Cap, class T>
+   constexpr bool mul_fast(const T* a, int na, const T* b, int nb, T* out, std::true_type) {
+      if (na < karatsuba_threshold || nb < karatsuba_threshold)
+         return false;
+      if (mul_ntt<Cap>(a, na, b, nb, out, use_ntt<T>()))
+         return true;
+      T scratch[mul_scratch(Cap)] {};
+      mul_general(a, na, b, nb, out, scratch);
+      return true;
+   }
+
+   template <int Cap, class T>
+   constexpr bool mul_fast(const T*, int, const T*, int, T*, std::false_type) {
+      return false;
+   }
+
+   /* Adds the product of a (na terms) and b (nb terms), truncated to nout
+    * terms, into out, which is zero.  The loops stop at the given lengths, not
+    * the capacities; Cap bounds na and nb. */
+   template <int Cap, class T>
+   constexpr void mul_trunc(const T* a, int na, const T* b, int nb, T* out, int nout) {
+      if (na + nb - 1 <= nout && mul_fast<Cap>(a, na, b, nb, out, use_karatsuba<T>()))
+         return;
+      for (int i = 0; i < na && i < nout; ++i) {
+         const int nj = std::min(nb, nout - i);
+         for (int j = 0; j < nj; ++j)
+            out[i+j] += a[i] * b[j];
+      }
+   }
+
+   // as mul_fast, for a squared
+   template <int Cap, class T>
+   constexpr bool sqr_fast(const T* a, int na, T* out) {
+      if (na < karatsuba_threshold)
+         return false;
+      if (mul_ntt<Cap>(a, na, a, na, out, use_ntt<T>()))
+         return true;
+      T scratch[mul_scratch(Cap)] {};
+      sqr_karatsuba(a, na, out, scratch);
+      return true;
+   }
+
+   /* As mul_trunc, for a squared: by the symmetric kernels where T allows
+    * reassociating (use_karatsuba), else as a product. */
+   template <int Cap, class T>
+   constexpr void sqr_trunc(const T* a, int na, T* out, int nout, std::true_type) {
+      if (2*na - 1 <= nout && sqr_fast<Cap>(a, na, out))
+         return;
+      sqr_schoolbook(a, na, out, nout);
+   }
+
+   template <int Cap, class T>
+   constexpr void sqr_trunc(const T* a, int na, T* out, int nout, std::false_type) {
+      mul_trunc<Cap>(a, na, a, na, out, nout);
+   }
+}
+
 template <class T, int N1, int N2>
 constexpr static_poly<T, N1 + N2 - 1> operator * (const static_poly<T, N1>& a, const static_poly<T, N2>& b) {
    static_poly<T, N1 + N2 - 1> prod;
-   if (!a || !b) { // a or b is zero
-      return prod;
-   }
-   for (int i = 0; i < N1; ++i)
-      for (int j = 0; j < N2; ++j)
-         prod[i+j] += a[i] * b[j];
+   const int na = a.degree() + 1, nb = b.degree() + 1;
+   if (na && nb) // else a or b is zero
+      detail::mul_trunc<std::max(N1, N2)>(a.m_data, na, b.m_data, nb, prod.m_data, N1 + N2 - 1);
    return prod;
 }
 
@@ -317,12 +489,19 @@ namespace detail {
    template <class T, int N, int N2>
    constexpr static_poly<T, N> mul(const static_poly<T, N>& a, const static_poly<T, N2>& b) {
       static_poly<T, N> prod;
-      if (!a || !b) { // a or b is zero
-         return prod;
-      }
-      for (int i = 0; i < N; ++i)
-         for (int j = 0; j < std::min(N - i, N2); ++j)
-            prod[i+j] += a[i] * b[j];
+      const int na = a.degree() + 1, nb = b.degree() + 1;
+      if (na && nb) // else a or b is zero
+         mul_trunc<std::max(N, N2)>(a.m_data, na, b.m_data, nb, prod.m_data, N);
+      return prod;
+   }
+
+   // a*a, likewise truncated to N terms
+   template <class T, int N>
+   constexpr static_poly<T, N> sqr(const static_poly<T, N>& a) {
+      static_poly<T, N> prod;
+      const int na = a.degree() + 1;
+      if (na)
+         sqr_trunc<N>(a.m_data, na, prod.m_data, N, use_karatsuba<T>());
       return prod;
    }
 }
@@ -354,8 +533,9 @@ constexpr bool operator != (const static_poly<T, N1> &a, const static_poly<T, N2
 template <class T, int N1, int N2>
 constexpr bool operator < (const static_poly<T, N1> &a, const static_poly<T, N2> &b) {
    int k = a.degree();
-   if (b.degree() != k)
-        return k < b.degree();
+   const int kb = b.degree();
+   if (kb != k)
+        return k < kb;
    for (; k >= 0; --k) {
       if (a[k] != b[k])
          return a[k] < b[k];
@@ -396,12 +576,63 @@ constexpr static_poly<T, N*exp> power(const static_poly<T, N>& b) {
         result = base;
     /* "Exponentiation by squaring" */
     while (ex >>= 1) {
-        base = detail::mul(base, base);
+        base = detail::sqr(base);
         if (ex & 1)
             result = detail::mul(result, base);
     }
     return result;
 }
+
+/* b^exp modulo x^K: the first K terms of power<exp>(b), with the intermediate
+ * products truncated to K terms as well. */
+template <int exp, int K, class T, int N>
+constexpr static_poly<T, K> power_trunc(const static_poly<T, N>& b) {
+   static_assert(exp >= 0, "Negative power not supported");
+   static_assert(K > 0, "Truncate to at least one term");
+   static_poly<T, K> result{T{1}};
+   static_poly<T, K> base{b}; // if N > K, drops the high terms
+   int ex = exp;
+   if (exp & 1)
+      result = base;
+   while (ex >>= 1) {
+      base = detail::sqr(base);
+      if (ex & 1)
+         result = detail::mul(result, base);
+   }
+   return result;
+}
+
+/* b^exp modulo m, reducing after every product, so nothing grows past twice
+ * the degree of m.  Over an integral type the leading coefficient of m must
+ * be 1 or -1, where long division gives true remainders (see
+ * use_monic_division); otherwise they are pseudo-remainders, multiplied by
+ * powers of that coefficient. */
+template <int exp, class T, int N1, int N2>
+constexpr static_poly<T, std::max(N2 - 1, 1)> power_mod(const static_poly<T, N1>& b, const static_poly<T, N2>& m) {
+   static_assert(exp >= 0, "Negative power not supported");
+   constexpr int R = std::max(N2 - 1, 1); // holds any remainder
+   constexpr int P = 2 * R - 1;           // holds the product of two
+   const int n = m.degree();
+   assert(n >= 0);
+   assert(!std::is_integral<T>::value || m[n] == T(1)
+          || detail::use_monic_division(m[n], std::is_integral<T>()));
+   static_poly<T, R> result;
+   if (n == 0)
+      return result; // everything is divisible by a constant
+   result[0] = T{1};
+   // room for a quotient of N1 terms, whatever the degree of m
+   static_poly<T, R> base(static_poly<T, N1 + N2 - 1>(b) % m);
+   int ex = exp;
+   if (exp & 1)
+      result = base;
+   while (ex >>= 1) {
+      base = static_poly<T, R>(detail::sqr(static_poly<T, P>(base)) % m);
+      if (ex & 1)
+         result = static_poly<T, R>((result * base) % m);
+   }
+   return result;
+}
+
 /* A pow with an argument for exp would be nice--
  * but how big must the result be? We can't determine the return type
  * at compile time. */
@@ -9,12 +9,22 @@
 
 #include <ostream>
 #include <cmath> //isnormal, fabs
+#include <complex>
 #include <boost/range/algorithm/find_if.hpp>
 #include <boost/range/algorithm/count_if.hpp>
 #include <boost/math/special_functions/relative_difference.hpp>
 #include "static_poly.hpp"
 
 /** Forward declarations for ostream inserter helpers **/
+template <class T, int N>
+struct tracked_poly;
+
+template <class T, class Alloc>
+struct dynamic_poly;
+
+template <class T, int N, int K>
+struct sparse_poly;
+
 namespace smath {
    template <typename T>
    struct complex;
@@ -61,6 +71,11 @@ namespace detail {
        return is_zero(ct.real) && is_zero(ct.imag.value);
    }
 
+   template <typename T>
+   bool is_zero(std::complex<T> ct) {
+       return is_zero(ct.real()) && is_zero(ct.imag());
+   }
+
    template <typename T>
    struct notone {
        T val;
@@ -89,6 +104,11 @@ namespace detail {
       return isone(n.real) && is_zero(n.imag.value);
    }
 
+   template <typename T>
+   bool isone(std::complex<T> n) {
+      return isone(n.real()) && is_zero(n.imag());
+   }
+
    template <typename T>
    std::ostream& operator << (std::ostream& os, notone<T> io) {
       if (isone(-io.val))
@@ -109,6 +129,12 @@ namespace detail {
             (is_zero(ct.real) && ct.imag.value < T{0} && !is_zero(ct.imag.value));
    }
 
+   template <typename T>
+   bool is_negative(std::complex<T> ct) {
+      return (ct.real() < T{0} && !is_zero(ct.real())) ||
+            (is_zero(ct.real()) && ct.imag() < T{0} && !is_zero(ct.imag()));
+   }
+
    template <typename T>
    bool is_negative(boost::math::quaternion<T> q) {
       // only if the first nonzero element is negative, and the majority of
@@ -165,30 +191,51 @@ namespace smath { // so it can be found
     }
 }
 
+namespace detail {
+   // poly, of degree i: a static_poly, tracked_poly or dynamic_poly
+   template <class Poly>
+   std::ostream& insert(std::ostream& os, const Poly& poly, int i) {
+      typedef typename Poly::value_type T;
+      if (i == -1)
+         return os << '0';
+      if (i == 0)
+         return os << poly[0];
+
+      os << ifnotone(poly[i]) << xpow{i};
+
+      for (--i; i > 0; --i) {
+         if (is_negative(poly[i]))
+            os << " - " << ifnotone(-poly[i]) << xpow{i};
+         else if (!is_zero(poly[i]))
+            os << " + " << ifnotone(poly[i]) << xpow{i};
+      }
+
+      if (is_negative(poly[0]))
+         os << " - " << -poly[0];
+      else if (poly[0] != T{0})
+         os << " + " << poly[0];
+      return os;
+   }
+}
+
 template <class T, int N>
 inline std::ostream& operator << (std::ostream& os, const static_poly<T, N>& poly) {
-   using namespace detail;
-
-   int i = poly.degree();
-   if (i == -1)
-      return os << '0';
-   if (i == 0)
-      return os << poly[0];
+   return detail::insert(os, poly, poly.degree());
+}
 
-   os << ifnotone(poly[i]) << xpow{i};
+template <class T, int N>
+inline std::ostream& operator << (std::ostream& os, const tracked_poly<T, N>& poly) {
+   return detail::insert(os, poly.poly(), poly.degree());
+}
 
-   for (--i; i > 0; --i) {
-      if (is_negative(poly[i]))
-         os << " - " << ifnotone(-poly[i]) << xpow{i};
-      else if (!is_zero(poly[i]))
-         os << " + " << ifnotone(poly[i]) << xpow{i};
-   }
+template <class T, class Alloc>
+inline std::ostream& operator << (std::ostream& os, const dynamic_poly<T, Alloc>& poly) {
+   return detail::insert(os, poly, poly.degree());
+}
 
-   if (is_negative(poly[0]))
-      os << " - " << -poly[0];
-   else if (poly[0] != T{0})
-      os << " + " << poly[0];
-   return os;
+template <class T, int N, int K>
+inline std::ostream& operator << (std::ostream& os, const sparse_poly<T, N, K>& poly) {
+   return detail::insert(os, poly.to_static(), poly.degree());
 }
 
 #endif // NAM_STATIC_POLYNOMIAL_IO_HPP 
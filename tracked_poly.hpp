@@ -0,0 +1,338 @@
+/*  static_poly with its degree kept alongside the coefficients.
+ *  Use, modification and distribution are subject to the
+ *  Boost Software License, Version 1.0. (See accompanying file
+ *  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+#ifndef NAM_TRACKED_POLY_HPP
+#define NAM_TRACKED_POLY_HPP
+
+#include <cassert>
+#include <algorithm> // min, max
+#include <utility> // pair
+#include <initializer_list>
+#include "static_poly.hpp"
+
+/* A static_poly<T, N> that knows its degree: degree() and operator bool don't
+ * scan, and the arithmetic loops run to the degrees of the operands rather
+ * than to N.  That pays when N is far above the actual degree, as in the
+ * results of power<>.  Coefficients are read with [] and written with set(),
+ * which keeps the degree up to date. */
+template <class T, int N>
+struct tracked_poly {
+   static_poly<T, N> m_poly;
+   int m_degree; // always m_poly.degree()
+
+   // typedefs:
+   typedef T value_type;
+   typedef int size_type;
+
+   // construct:
+   constexpr tracked_poly() : m_poly{}, m_degree(-1) {}
+
+   template <class U, int M>
+   explicit constexpr tracked_poly(const U (&data)[M])
+   : m_poly(data), m_degree(m_poly.degree()) {}
+
+   template <class It>
+   constexpr tracked_poly(It first, It last)
+   : m_poly(first, last), m_degree(m_poly.degree()) {}
+
+   template <class U>
+   explicit constexpr tracked_poly(const U& point)
+   : m_poly(point), m_degree(m_poly.degree()) {}
+
+   template <class U, int N1>
+   explicit constexpr tracked_poly(const static_poly<U, N1>& p)
+   : m_poly(p), m_degree(m_poly.degree()) {}
+
+   template <class U, int N1>
+   explicit constexpr tracked_poly(const tracked_poly<U, N1>& p)
+   : m_poly(p.m_poly), m_degree(detail::degree_from(m_poly.m_data, std::min(p.degree(), N - 1))) {}
+
+   // p, whose degree is known to be at most top
+   constexpr tracked_poly(const static_poly<T, N>& p, int top)
+   : m_poly(p), m_degree(detail::degree_from(p.m_data, std::min(top, N - 1))) {}
+
+   constexpr tracked_poly(std::initializer_list<T> l)
+   : m_poly(l), m_degree(m_poly.degree()) {}
+
+   // access:
+   constexpr size_type size() const {
+      return N;
+   }
+
+   constexpr size_type degree() const {
+      return m_degree;
+   }
+
+   constexpr const T& operator[] (size_type i) const {
+      return m_poly[i];
+   }
+
+   constexpr void set(size_type i, const T& value) {
+      m_poly[i] = value;
+      if (i > m_degree && value != T{0})
+         m_degree = i;
+      else if (i == m_degree && value == T{0})
+         m_degree = detail::degree_from(m_poly.m_data, i - 1);
+   }
+
+   constexpr const static_poly<T, N>& poly() const {
+      return m_poly;
+   }
+
+   // Horner's rule on the degree + 1 terms
+   constexpr T operator() (T z) const {
+      return evaluate_polynomial(m_poly.m_data, z, m_degree + 1);
+   }
+
+   // evaluate all N terms with a particular scheme from polynomial_schemes.hpp
+   template <class Scheme = auto_scheme>
+   constexpr T evaluate(T z) const {
+      return m_poly.template evaluate<Scheme>(z);
+   }
+
+   constexpr const std::pair<const T*, const T*> data() const {
+      return std::make_pair(m_poly.m_data, m_poly.m_data + m_degree + 1);
+   }
+
+   // operators:
+   template <class U>
+   constexpr tracked_poly& operator +=(const U& value) {
+      m_poly += value;
+      if (m_degree <= 0)
+         m_degree = m_poly[0] != T{0} ? 0 : -1;
+      return *this;
+   }
+
+   template <class U>
+   constexpr tracked_poly& operator -=(const U& value) {
+      m_poly -= value;
+      if (m_degree <= 0)
+         m_degree = m_poly[0] != T{0} ? 0 : -1;
+      return *this;
+   }
+
+   // these can zero the leading coefficient (multiplying by zero, say), so rescan
+   template <class U>
+   constexpr tracked_poly& operator *=(const U& value) {
+      for (int i = 0; i <= m_degree; ++i)
+         m_poly[i] *= value;
+      m_degree = detail::degree_from(m_poly.m_data, m_degree);
+      return *this;
+   }
+
+   template <class U>
+   constexpr tracked_poly& operator /=(const U& value) {
+      for (int i = 0; i <= m_degree; ++i)
+         m_poly[i] /= value;
+      m_degree = detail::degree_from(m_poly.m_data, m_degree);
+      return *this;
+   }
+
+   template <class U>
+   constexpr tracked_poly& operator %=(const U& value) {
+      // as static_poly::operator%=
+      if (std::is_integral<T>::value) {
+         for (int i = 0; i <= m_degree; ++i)
+            m_poly[i] -= T(value * T(m_poly[i] / value));
+         m_degree = detail::degree_from(m_poly.m_data, m_degree);
+      } else {
+         for (int i = 0; i <= m_degree; ++i)
+            m_poly[i] = 0;
+         m_degree = -1;
+      }
+      return *this;
+   }
+
+   explicit constexpr operator bool() const {
+      return m_degree >= 0;
+   }
+};
+
+template <class T, int N, class U>
+constexpr tracked_poly<T, N> operator + (tracked_poly<T, N> a, const U& b) {
+   return a += b;
+}
+
+template <class T, int N, class U>
+constexpr tracked_poly<T, N> operator - (tracked_poly<T, N> a, const U& b) {
+   return a -= b;
+}
+
+template <class T, int N, class U>
+constexpr tracked_poly<T, N> operator * (tracked_poly<T, N> a, const U& b) {
+   return a *= b;
+}
+
+template <class T, int N, class U>
+constexpr tracked_poly<T, N> operator / (tracked_poly<T, N> a, const U& b) {
+   return a /= b;
+}
+
+template <class T, int N, class U>
+constexpr tracked_poly<T, N> operator % (tracked_poly<T, N> a, const U& b) {
+   return a %= b;
+}
+
+template <class U, class T, int N>
+constexpr tracked_poly<T, N> operator + (const U& a, tracked_poly<T, N> b) {
+   return b += a;
+}
+
+template <class U, class T, int N>
+constexpr tracked_poly<T, N> operator - (const U& a, const tracked_poly<T, N>& b) {
+   return -b + a;
+}
+
+template <class U, class T, int N>
+constexpr tracked_poly<T, N> operator * (const U& a, tracked_poly<T, N> b) {
+   return b *= a;
+}
+
+// Unary minus (negate).
+template <class T, int N>
+constexpr tracked_poly<T, N> operator - (tracked_poly<T, N> a) {
+   for (int i = 0; i <= a.m_degree; ++i)
+      a.m_poly[i] *= -1;
+   return a;
+}
+
+template <class T, int N1, int N2>
+constexpr tracked_poly<T, std::max(N1, N2)> operator + (const tracked_poly<T, N1>& a, const tracked_poly<T, N2>& b) {
+   static_poly<T, std::max(N1, N2)> sum(a.m_poly);
+   for (int i = 0; i <= b.degree(); ++i)
+      sum[i] += b[i];
+   // the leading terms can only cancel when the degrees are the same
+   return {sum, std::max(a.degree(), b.degree())};
+}
+
+template <class T, int N1, int N2>
+constexpr tracked_poly<T, std::max(N1, N2)> operator - (const tracked_poly<T, N1>& a, const tracked_poly<T, N2>& b) {
+   static_poly<T, std::max(N1, N2)> diff(a.m_poly);
+   for (int i = 0; i <= b.degree(); ++i)
+      diff[i] -= b[i];
+   return {diff, std::max(a.degree(), b.degree())};
+}
+
+template <class T, int N1, int N2>
+constexpr tracked_poly<T, N1 + N2 - 1> operator * (const tracked_poly<T, N1>& a, const tracked_poly<T, N2>& b) {
+   static_poly<T, N1 + N2 - 1> prod;
+   if (!a || !b) { // a or b is zero
+      return {};
+   }
+   detail::mul_trunc<std::max(N1, N2)>(a.m_poly.m_data, a.degree() + 1, b.m_poly.m_data, b.degree() + 1,
+                                       prod.m_data, N1 + N2 - 1);
+   return {prod, a.degree() + b.degree()};
+}
+
+namespace detail {
+   // as detail::mul in static_poly.hpp: the product truncated to N terms
+   template <class T, int N, int N2>
+   constexpr tracked_poly<T, N> mul(const tracked_poly<T, N>& a, const tracked_poly<T, N2>& b) {
+      static_poly<T, N> prod;
+      if (!a || !b) { // a or b is zero
+         return {};
+      }
+      mul_trunc<std::max(N, N2)>(a.m_poly.m_data, a.degree() + 1, b.m_poly.m_data, b.degree() + 1,
+                                 prod.m_data, N);
+      return {prod, a.degree() + b.degree()};
+   }
+
+   template <class T, int N>
+   constexpr tracked_poly<T, N> sqr(const tracked_poly<T, N>& a) {
+      static_poly<T, N> prod;
+      if (!a) {
+         return {};
+      }
+      sqr_trunc<N>(a.m_poly.m_data, a.degree() + 1, prod.m_data, N, use_karatsuba<T>());
+      return {prod, 2 * a.degree()};
+   }
+}
+
+/* Calculates a / b and a % b, as quotient_remainder on static_polys does, with
+ * the degrees already at hand.
+ * This function is not defined for division by zero: user beware.
+ */
+template <typename T, int N1, int N2>
+std::pair< tracked_poly<T, std::max(N1 - N2 + 1, 1)>, tracked_poly<T, std::min(N1, N2)> >
+constexpr quotient_remainder(const tracked_poly<T, N1>& dividend, const tracked_poly<T, N2>& divisor) {
+   assert(divisor);
+   constexpr int sz = std::max(N1 - N2 + 1, 1);
+   const int m = dividend.degree(), n = divisor.degree();
+   if (m < n)
+      return std::make_pair(tracked_poly<T, sz>(), tracked_poly<T, std::min(N1, N2)>(dividend));
+   const auto qr = detail::division(dividend.m_poly, divisor.m_poly, m, n);
+   return std::make_pair(tracked_poly<T, sz>(qr.first, m - n),
+                         tracked_poly<T, std::min(N1, N2)>(qr.second, n - 1));
+}
+
+template <class T, int N1, int N2>
+constexpr tracked_poly<T, std::max(N1 - N2 + 1, 1)> operator / (const tracked_poly<T, N1>& a, const tracked_poly<T, N2>& b) {
+   return quotient_remainder(a, b).first;
+}
+
+template <class T, int N1, int N2>
+constexpr tracked_poly<T, std::min(N1, N2)> operator % (const tracked_poly<T, N1>& a, const tracked_poly<T, N2>& b) {
+   return quotient_remainder(a, b).second;
+}
+
+template <class T, int N1, int N2>
+constexpr bool operator == (const tracked_poly<T, N1> &a, const tracked_poly<T, N2> &b) {
+   int n = a.degree();
+   if (b.degree() != n) return false;
+   for (; n >= 0; --n)
+      if (a[n] != b[n]) return false;
+   return true;
+}
+
+template <class T, int N1, int N2>
+constexpr bool operator != (const tracked_poly<T, N1> &a, const tracked_poly<T, N2> &b) {
+   return !(a == b);
+}
+
+template <class T, int N1, int N2>
+constexpr bool operator < (const tracked_poly<T, N1> &a, const tracked_poly<T, N2> &b) {
+   int k = a.degree();
+   if (b.degree() != k)
+        return k < b.degree();
+   for (; k >= 0; --k) {
+      if (a[k] != b[k])
+         return a[k] < b[k];
+   }
+   return false; // equal
+}
+
+template <class T, int N1, int N2>
+constexpr bool operator <= (const tracked_poly<T, N1> &a, const tracked_poly<T, N2> &b) {
+   return a < b || a == b;
+}
+
+template <class T, int N1, int N2>
+constexpr bool operator >= (const tracked_poly<T, N1> &a, const tracked_poly<T, N2> &b) {
+   return !(a < b);
+}
+
+template <class T, int N1, int N2>
+constexpr bool operator > (const tracked_poly<T, N1> &a, const tracked_poly<T, N2> &b) {
+   return !(a <= b);
+}
+
+template <int exp, class T, int N>
+constexpr tracked_poly<T, N*exp> power(const tracked_poly<T, N>& b) {
+   static_assert(exp >= 0, "Negative power not supported");
+   tracked_poly<T, N*exp> result{T{1}};
+   tracked_poly<T, N*exp> base{b};
+   int ex = exp;
+   if (exp & 1)
+      result = base;
+   /* "Exponentiation by squaring" */
+   while (ex >>= 1) {
+      base = detail::sqr(base);
+      if (ex & 1)
+         result = detail::mul(result, base);
+   }
+   return result;
+}
+
+#endif // NAM_TRACKED_POLY_HPP